@@ -12,6 +12,7 @@
  *   - ::PaletteAnimated
  *   - ::Animated
  *   - ::Auto
+ *   - ::AudioReactive, if MICROPHONE_PIN is defined
  * - Accepts input from potentiometer to change brightness.
  * - Accepts input from 2 buttons to change modes and choose colors/animations.
  * - Buttons and potentiometer can be combined to change animation speed and color temperature.
@@ -21,19 +22,38 @@
 #include <stdint.h>
 #include "src/input/input-buttons.cpp"
 #include "src/input/input-potentiometer.cpp"
+#include "src/input/input-microphone.cpp"
+#include "hardware-config.h"
 
 /**
  * Must be equal to number of values in ::Mode
  */
+#ifdef MICROPHONE_PIN
+#define NUM_MODES 5
+#else
 #define NUM_MODES 4
+#endif
 enum Mode: uint8_t {
   Static = 0,              ///< All lights same color, no animation
   MonochromeAnimated = 1,  ///< All lights same base hue with animation
   PaletteAnimated = 2,     ///< Same as MonochromeAnimated but using predefined sets of colors
   Animated = 3,            ///< Animations with any color,
+  AudioReactive = 4,       ///< Palette colors driven by sound from the microphone
+};
+
+/**
+ * An animation and how often it needs to be fully rendered.
+ */
+struct AnimationDescriptor {
+  void (*render)(CRGB leds[]);
+
+  /// Fully render every Nth frame and interpolate in between. Must be 1 for
+  /// animations that read back the previous frame.
+  uint8_t keyframe_interval;
 };
 
 void draw(void);
+void render(const AnimationDescriptor& animation);
 
 void setupInputHandlers(void);
 void updateInputHandlers(void);
@@ -71,4 +91,12 @@ class BrightnessPotentiometerHandler: public AbstractPotentiometerHandler {
   void onValueChangedWithOptionButton(int value); ///< Called when the pot is turned while the Option button is held down
 };
 
+#ifdef MICROPHONE_PIN
+class MicrophoneHandler: public AbstractMicrophoneHandler {
+  public:
+  MicrophoneHandler(uint8_t pin): AbstractMicrophoneHandler(pin) {}
+  void onAudioAnalyzed(const AudioAnalyzer& analyzer);
+};
+#endif
+
 #endif
@@ -12,6 +12,7 @@
  *   - ::PaletteAnimated
  *   - ::Animated
  *   - ::Auto
+ *   - ::AudioReactive, if MICROPHONE_PIN is defined
  * - Implemented hardware controls:
  *  - Change brightness by turning pot: BrightnessPotentiometerHandler::onValueChangedNoModifier
  *  - Change mode by pressing Mode button: ModeButtonHandler::onButtonPressed
@@ -32,15 +33,23 @@
 #include "colors.h"
 #include "hardware-config.h"
 #include "src/animation/animations.h"
+#include "src/animation/keyframes.h"
+#include "src/output/output.h"
 FASTLED_USING_NAMESPACE
 
+using animations::MainStrip;
+
 #if defined(FASTLED_VERSION) && (FASTLED_VERSION < 3001000)
 #warning "Requires FastLED 3.1 or later; check github for latest code."
 #endif
 
 #define FRAMES_PER_SECOND_DEFAULT 120
 
+#ifdef PIPELINED_OUTPUT
+CRGB* leds_ = output::firstBuffer();  ///< Changes after each frame: see output::show()
+#else
 CRGB leds_[NUM_LEDS];
+#endif
 
 uint8_t frames_per_second_ = FRAMES_PER_SECOND_DEFAULT;
 
@@ -68,39 +77,55 @@ bool auto_cycle_ = false; ///< If true, modes and colors will be changed automat
 ModeButtonHandler mode_button_handler_(MODE_BUTTON_PIN);
 OptionButtonHandler option_button_handler_(OPTION_BUTTON_PIN);
 BrightnessPotentiometerHandler brightness_potentiometer_handler_(BRIGHTNESS_POT_PIN);
+#ifdef MICROPHONE_PIN
+MicrophoneHandler microphone_handler_(MICROPHONE_PIN);
+#endif
 
-typedef void (*AnimationList[])(CRGB* leds);
+typedef const AnimationDescriptor AnimationList[];
 /**
  * Animations used when mode_ is ::Animated
  */
 AnimationList full_color_animations_ = {
-  // animations::polychromeSplash,
-  animations::polychromeRainbow,
-  animations::polychromeRainbowWithGlitter,
-  animations::polychromeConfetti,
-  animations::polychromeSinelon,
-  animations::polychromeJuggle,
-  animations::polychromeBpm,
-  animations::monochromeRainbow,
+  // { animations::polychromeSplash<MainStrip>, 1 },
+  { animations::polychromeRainbow<MainStrip>, 4 },
+  { animations::polychromeRainbowWithGlitter<MainStrip>, 1 },
+  { animations::polychromeConfetti<MainStrip>, 1 },
+  { animations::polychromeSinelon<MainStrip>, 1 },
+  { animations::polychromeJuggle<MainStrip>, 1 },
+  { animations::polychromeBpm<MainStrip>, 3 },
+  { animations::monochromeRainbow<MainStrip>, 1 },
+  { animations::twinkleFairyLights<MainStrip>, 1 },
+#ifdef MATRIX_WIDTH
+  { animations::matrixSinelon<MainStrip>, 1 },
+  { animations::matrixJuggle<MainStrip>, 1 },
+#endif
 };
 
 /**
  * Animations used when mode_ is ::MonochromeAnimated
  */
 AnimationList monochrome_animations_ = {
-  animations::monochromeGlitter,
-  animations::monochromeSinelon,
-  animations::monochromeJuggle,
-  animations::monochromePulse,
+  { animations::monochromeGlitter<MainStrip>, 1 },
+  { animations::monochromeSinelon<MainStrip>, 1 },
+  { animations::monochromeJuggle<MainStrip>, 1 },
+  { animations::monochromePulse<MainStrip>, 1 },
+  { animations::twinkleMonochrome<MainStrip>, 1 },
 };
 
 /**
  * Animations used when mode_ is ::PaletteAnimated
  */
 AnimationList palette_animations_ = {
-  animations::paletteFlow,
-  animations::paletteFlowWithGlitter,
-  animations::paletteGlitter,
+  { animations::paletteFlow<MainStrip>, 4 },
+  { animations::paletteFlowWithGlitter<MainStrip>, 1 },
+  { animations::paletteGlitter<MainStrip>, 1 },
+  { animations::noiseFire<MainStrip>, 1 },
+  { animations::noiseClouds<MainStrip>, 1 },
+  { animations::noiseAurora<MainStrip>, 1 },
+  { animations::twinklePalette<MainStrip>, 1 },
+#ifdef MATRIX_WIDTH
+  { animations::matrixFlow<MainStrip>, 4 },
+#endif
 };
 
 /**
@@ -166,9 +191,12 @@ void setup(void) {
   animations::hue_ = animations::static_color_hsv_.hue;
 
   // tell FastLED about the LED strip configuration
-  FastLED.addLeds<LED_TYPE, DATA_PIN, COLOR_ORDER>(leds_, NUM_LEDS)
+  FastLED.addLeds<LED_TYPE, DATA_PIN, MainStrip::ORDER>(leds_, MainStrip::LENGTH)
       .setCorrection(COLOR_CORRECTION);
   FastLED.setTemperature(COLOR_TEMPERATURE);
+  #ifdef PIPELINED_OUTPUT
+  output::setup();
+  #endif
 
   PRINTLN("OK GO");
 }
@@ -177,6 +205,8 @@ void setup(void) {
  * Arduino loop runs repeatedly after setup() completes.
  */
 void loop(void) {
+  static uint8_t rendered_mode = mode_;
+
   updateInputHandlers();
   EVERY_N_MILLISECONDS(20) {
     animations::hue_++;
@@ -189,28 +219,80 @@ void loop(void) {
     }
   }
 
+  #ifdef MICROPHONE_PIN
+  if (mode_ == Mode::AudioReactive) {
+    EVERY_N_SECONDS(10) {
+      PRINT("audio us/frame: ");
+      PRINTLN(microphone_handler_.cpuMicros());
+    }
+  }
+  #endif
+
+  if (mode_ != rendered_mode) {
+    // Other modes draw without keyframes, so the latest keyframe is stale.
+    keyframes::reset<MainStrip>();
+    rendered_mode = mode_;
+  }
+
   switch (mode_) {
     case Mode::Static:
-      animations::transitionLinearToSolid(leds_, getCurrentColor());
+      animations::transitionLinearToSolid<MainStrip>(leds_, getCurrentColor());
       break;
     case Mode::MonochromeAnimated:
-      monochrome_animations_[monochrome_animation_index_](leds_);
+      render(monochrome_animations_[monochrome_animation_index_]);
       break;
     case Mode::Animated:
-      full_color_animations_[animation_index_](leds_);
+      render(full_color_animations_[animation_index_]);
       break;
     case Mode::PaletteAnimated:
-      palette_animations_[palette_animation_index_](leds_);
+      render(palette_animations_[palette_animation_index_]);
+      break;
+    #ifdef MICROPHONE_PIN
+    case Mode::AudioReactive:
+      animations::audioPalette<MainStrip>(leds_);
       break;
+    #endif
   }
 
   draw();
 }
 
+/**
+ * Render the given animation into leds_, interpolating between keyframes if
+ * the animation allows it.
+ */
+void render(const AnimationDescriptor& animation) {
+  keyframes::render<MainStrip>(leds_, animation.render, animation.keyframe_interval);
+}
+
 void draw(void) {
   FastLED.setBrightness(brightness_);
+  #ifdef PIPELINED_OUTPUT
+  leds_ = output::show(leds_);
+  #else
   FastLED.show();
+  #endif
+  #ifdef MICROPHONE_PIN
+  if (mode_ == Mode::AudioReactive) {
+    // Record the next block of audio while waiting for the next frame.
+    // FastLED.delay() would call show() again, which holds off the ADC interrupt on AVR.
+    microphone_handler_.startSampling();
+    #ifdef ADC_SAMPLER
+    delay(1000 / frames_per_second_);
+    #else
+    // Sampling blocked for part of the frame already: wait out the rest.
+    const unsigned long frame_micros = 1000000UL / frames_per_second_;
+    const unsigned long sampling_micros = microphone_handler_.cpuMicros();
+    delay(sampling_micros < frame_micros ? (frame_micros - sampling_micros) / 1000 : 0);
+    #endif
+    return;
+  }
+  #endif
+  #ifdef PIPELINED_OUTPUT
+  delay(1000 / frames_per_second_);  // FastLED.delay() would call show() from this thread.
+  #else
   FastLED.delay(1000 / frames_per_second_);
+  #endif
 }
 
 void setupInputHandlers(void) {
@@ -219,6 +301,10 @@ void setupInputHandlers(void) {
 }
 
 void updateInputHandlers(void) {
+  #ifdef MICROPHONE_PIN
+  // First, so the ADC is free again before the potentiometer is read.
+  microphone_handler_.update();
+  #endif
   brightness_potentiometer_handler_.update();
   mode_button_handler_.update();
   option_button_handler_.update();
@@ -320,6 +406,7 @@ void OptionButtonHandler::onButtonPressed(void) {
       PRINTLN(colors_[static_color_index_]);
       break;
     case Mode::PaletteAnimated:
+    case Mode::AudioReactive:
       nextPalette();
       PRINT("nextPalette:");
       PRINTLN(palette_index_);
@@ -341,6 +428,18 @@ void OptionButtonHandler::onLongPress(void) {
   }
 }
 
+#ifdef MICROPHONE_PIN
+/**
+ * Pass the latest band levels and beat to the audio animations.
+ */
+void MicrophoneHandler::onAudioAnalyzed(const AudioAnalyzer& analyzer) {
+  for (uint8_t band = 0; band < AUDIO_BANDS; band++) {
+    animations::audio_levels_[band] = analyzer.level(band);
+  }
+  animations::audio_beat_ = analyzer.isBeat();
+}
+#endif
+
 void BrightnessPotentiometerHandler::onValueChanged(const int value) {
   if (mode_button_handler_.isDown()) {
     onValueChangedWithModeButton(value);
@@ -26,13 +26,56 @@ FASTLED_NAMESPACE_END
 
 #define SERIAL_BAUD_RATE 115200
 
+/**
+ * Uncomment MATRIX_WIDTH and MATRIX_HEIGHT to drive a 2D panel instead of a
+ * single strip. Dimensions are as seen by the viewer, after rotation.
+ */
+// #define MATRIX_WIDTH 16
+// #define MATRIX_HEIGHT 16
+
+/// If true, alternate rows of the panel are wired in opposite directions.
+#define MATRIX_SERPENTINE true
+
+/// Number of clockwise quarter turns between the panel wiring and the viewer.
+#define MATRIX_ROTATION 0
+
+#ifdef MATRIX_WIDTH
+#define NUM_LEDS (MATRIX_WIDTH * MATRIX_HEIGHT)
+#else
 #define NUM_LEDS 150
+#endif
+
+/**
+ * Uncomment to render smooth animations only every few frames and
+ * interpolate between them. Costs an extra 3 bytes of RAM per LED, which an
+ * Uno driving 150 LEDs can barely spare.
+ */
+// #define KEYFRAME_INTERPOLATION
+
+/**
+ * Uncomment on ESP32 to render each frame on one core while the previous one
+ * is transmitted from the other. Needs RAM for a second frame buffer, and is
+ * not supported on single-core boards such as the Uno.
+ */
+// #define PIPELINED_OUTPUT
 
 #define DATA_PIN 4
 #define BRIGHTNESS_POT_PIN 0
 #define MODE_BUTTON_PIN 9
 #define OPTION_BUTTON_PIN 8
 
+/**
+ * Uncomment to enable ::AudioReactive mode using an analog microphone on this pin.
+ */
+// #define MICROPHONE_PIN 1
+
+/**
+ * Microphone sample rate on boards that read it with analogRead(). AVR boards
+ * sample in the background with the ADC running freely instead: see
+ * src/audio/adc-sampler.h.
+ */
+#define AUDIO_SAMPLE_RATE 8000
+
 #define MAX_BRIGHTNESS 245
 #define MIN_BRIGHTNESS 5
 
@@ -4,11 +4,20 @@
 #define ANIMATIONS_H
 #include <FastLED.h>
 #include "../../hardware-config.h"
+#include "framebuffer.h"
+#include "strip.h"
+#include "../layout/layout.h"
+#include "../audio/audio-analyzer.h"
 
 FASTLED_USING_NAMESPACE
 
-#define FADE(A) fadeToBlackBy(leds, NUM_LEDS, A)
+#define FADE(A) framebuffer::fade(leds, Strip::LENGTH, A)
 
+/*
+ * Animations are templates on a strip configuration from strip.h, and are
+ * compiled for each configuration listed in FOR_EACH_STRIP, e.g.
+ * animations::paletteFlow<animations::MainStrip>.
+ */
 namespace animations {
 #define CHANCE_OF_GLITTER 80
 #define GLITTER_COLOR CRGB::Pink
@@ -18,33 +27,58 @@ extern float animation_speed_multiplier_;
 extern CRGBPalette16 palette_;
 extern uint8_t transition_progress_;
 
+template <typename Strip>
 void addGlitter(CRGB leds[], CRGB glitter_color = GLITTER_COLOR, fract8 chance_of_glitter = CHANCE_OF_GLITTER);
 
 // Animations with any color
-void polychromeBpm(CRGB leds[]);
-void polychromeConfetti(CRGB leds[]);
-void polychromeJuggle(CRGB leds[]);
-void polychromeRainbow(CRGB leds[]);
-void polychromeRainbowWithGlitter(CRGB leds[]);
-void polychromeSinelon(CRGB leds[]);
-void polychromeStorm(CRGB leds[]);   // Lightning
-void polychromeSplash(CRGB leds[]);  // Spread out from central point
-void monochromeRainbow(CRGB leds[]);
+template <typename Strip> void polychromeBpm(CRGB leds[]);
+template <typename Strip> void polychromeConfetti(CRGB leds[]);
+template <typename Strip> void polychromeJuggle(CRGB leds[]);
+template <typename Strip> void polychromeRainbow(CRGB leds[]);
+template <typename Strip> void polychromeRainbowWithGlitter(CRGB leds[]);
+template <typename Strip> void polychromeSinelon(CRGB leds[]);
+template <typename Strip> void polychromeStorm(CRGB leds[]);   // Lightning
+template <typename Strip> void polychromeSplash(CRGB leds[]);  // Spread out from central point
+template <typename Strip> void monochromeRainbow(CRGB leds[]);
 
 // Monochromatic animations
-void monochromeJuggle(CRGB leds[]);
-void monochromeGlitter(CRGB leds[]);
-void monochromeSinelon(CRGB leds[]);
-void monochromePulse(CRGB leds[]);
+template <typename Strip> void monochromeJuggle(CRGB leds[]);
+template <typename Strip> void monochromeGlitter(CRGB leds[]);
+template <typename Strip> void monochromeSinelon(CRGB leds[]);
+template <typename Strip> void monochromePulse(CRGB leds[]);
 
 // Palette animations
-void paletteFlow(CRGB leds[]);
-void paletteFlowWithGlitter(CRGB leds[]);
-void paletteGlitter(CRGB leds[]);
+template <typename Strip> void paletteFlow(CRGB leds[]);
+template <typename Strip> void paletteFlowWithGlitter(CRGB leds[]);
+template <typename Strip> void paletteGlitter(CRGB leds[]);
+
+// Twinkling animations, each LED independent
+template <typename Strip> void twinkleFairyLights(CRGB leds[]);
+template <typename Strip> void twinkleMonochrome(CRGB leds[]);
+template <typename Strip> void twinklePalette(CRGB leds[]);
+
+// Noise animations, using palette_
+template <typename Strip> void noiseAurora(CRGB leds[]);
+template <typename Strip> void noiseClouds(CRGB leds[]);
+template <typename Strip> void noiseFire(CRGB leds[]);
+
+#ifdef MICROPHONE_PIN
+extern uint8_t audio_levels_[AUDIO_BANDS];  ///< Latest level of each band from the microphone
+extern bool audio_beat_;                    ///< True for the frame in which a beat was detected
+
+// Audio-reactive animations
+template <typename Strip> void audioPalette(CRGB leds[]);
+#endif
+
+// 2D animations for LED panels, compiled for each configuration listed in
+// FOR_EACH_PANEL. Strip::Layout gives the position of each pixel.
+template <typename Strip> void matrixFlow(CRGB leds[]);
+template <typename Strip> void matrixJuggle(CRGB leds[]);
+template <typename Strip> void matrixSinelon(CRGB leds[]);
 
 // Transitional animations
-void transitionFadeToSolid(CRGB leds[], CRGB target_color);
-void transitionLinearToSolid(CRGB leds[], CRGB target_color);
+template <typename Strip> void transitionFadeToSolid(CRGB leds[], CRGB target_color);
+template <typename Strip> void transitionLinearToSolid(CRGB leds[], CRGB target_color);
 
 }  // namespace animations
 
@@ -0,0 +1,31 @@
+/** @file */
+#include <FastLED.h>
+#include "animations.h"
+
+#ifdef MICROPHONE_PIN
+FASTLED_USING_NAMESPACE
+namespace animations {
+
+uint8_t audio_levels_[AUDIO_BANDS] = {0};
+bool audio_beat_ = false;
+
+template <typename Strip>
+void audioPalette(CRGB leds[]) {
+  // Bass sets the brightness, mids and treble push the colors along the
+  // palette, and each beat jumps to a new part of the palette.
+  if (audio_beat_) {
+    hue_ += 64;
+  }
+  const uint8_t position = hue_ + (audio_levels_[1] >> 2) + (audio_levels_[2] >> 2) + (audio_levels_[3] >> 2);
+  const uint8_t brightness = qadd8(40, scale8(audio_levels_[0], 215));
+  fill_palette(leds, Strip::LENGTH, position, 15, palette_, brightness, LINEARBLEND);
+}
+
+#define INSTANTIATE_ANIMATIONS(STRIP) \
+  template void audioPalette<STRIP>(CRGB leds[]);
+FOR_EACH_STRIP(INSTANTIATE_ANIMATIONS)
+#undef INSTANTIATE_ANIMATIONS
+
+}  // namespace animations
+FASTLED_NAMESPACE_END
+#endif
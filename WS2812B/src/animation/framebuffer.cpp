@@ -0,0 +1,241 @@
+/** @file */
+#include "framebuffer.h"
+#include <FastLED.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define FRAMEBUFFER_SSE2
+#elif !defined(__AVR__)
+#define FRAMEBUFFER_SWAR
+#endif
+
+FASTLED_USING_NAMESPACE
+namespace framebuffer {
+namespace {
+
+/**
+ * A solid color repeats every 3 bytes, so a run of 16 pixels (48 bytes)
+ * lines up with both 4-byte and 16-byte blocks.
+ */
+#define PATTERN_PIXELS 16
+#define PATTERN_BYTES (PATTERN_PIXELS * 3)
+
+#if defined(FRAMEBUFFER_SSE2)
+typedef __m128i Block;
+
+inline Block load(const uint8_t* p) {
+  return _mm_loadu_si128((const __m128i*) p);
+}
+
+inline void store(uint8_t* p, Block block) {
+  _mm_storeu_si128((__m128i*) p, block);
+}
+
+#elif defined(FRAMEBUFFER_SWAR)
+typedef uint32_t Block;
+
+#define EVEN_BYTES 0x00FF00FFUL
+#define ODD_BYTES 0xFF00FF00UL
+#define HIGH_BITS 0x80808080UL
+#define LOW_BITS 0x7F7F7F7FUL
+
+// memcpy keeps unaligned access legal on cores that would otherwise fault.
+inline Block load(const uint8_t* p) {
+  Block block;
+  memcpy(&block, p, sizeof(Block));
+  return block;
+}
+
+inline void store(uint8_t* p, Block block) {
+  memcpy(p, &block, sizeof(Block));
+}
+
+/// Expand the high bit of each byte into a full 0xFF/0x00 byte mask.
+inline Block byteMask(Block high_bits) {
+  return (high_bits << 1) - (high_bits >> 7);
+}
+#endif
+
+/*
+ * Each operation provides a per-byte version, matching the FastLED primitive,
+ * and a per-block version that must give identical results.
+ */
+
+struct Scale {
+  static uint8_t byte(uint8_t a, uint8_t, uint8_t scale) {
+    return scale8(a, scale);
+  }
+
+#if defined(FRAMEBUFFER_SSE2)
+  static Block block(Block a, Block, uint8_t scale) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i factor = _mm_set1_epi16((uint16_t) scale + 1);
+    __m128i lo = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(a, zero), factor), 8);
+    __m128i hi = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(a, zero), factor), 8);
+    return _mm_packus_epi16(lo, hi);
+  }
+#elif defined(FRAMEBUFFER_SWAR)
+  static Block block(Block a, Block, uint8_t scale) {
+    // Every byte gets its own 16-bit lane so products cannot carry into a neighbour.
+    const Block factor = (Block) scale + 1;
+    const Block even = (((a & EVEN_BYTES) * factor) >> 8) & EVEN_BYTES;
+    const Block odd = (((a >> 8) & EVEN_BYTES) * factor) & ODD_BYTES;
+    return even | odd;
+  }
+#endif
+};
+
+struct Add {
+  static uint8_t byte(uint8_t a, uint8_t b, uint8_t) {
+    return qadd8(a, b);
+  }
+
+#if defined(FRAMEBUFFER_SSE2)
+  static Block block(Block a, Block b, uint8_t) {
+    return _mm_adds_epu8(a, b);
+  }
+#elif defined(FRAMEBUFFER_SWAR)
+  static Block block(Block a, Block b, uint8_t) {
+    // Add the low 7 bits of each byte, then work out the carry out of bit 7.
+    const Block low_sum = (a & LOW_BITS) + (b & LOW_BITS);
+    const Block carry = ((a & b) | ((a | b) & low_sum)) & HIGH_BITS;
+    const Block sum = low_sum ^ ((a ^ b) & HIGH_BITS);
+    return sum | byteMask(carry);
+  }
+#endif
+};
+
+struct Lighten {
+  static uint8_t byte(uint8_t a, uint8_t b, uint8_t) {
+    return a > b ? a : b;
+  }
+
+#if defined(FRAMEBUFFER_SSE2)
+  static Block block(Block a, Block b, uint8_t) {
+    return _mm_max_epu8(a, b);
+  }
+#elif defined(FRAMEBUFFER_SWAR)
+  static Block block(Block a, Block b, uint8_t) {
+    // Subtract with the high bit of a forced on so no byte borrows from its
+    // neighbour, then work out the borrow out of bit 7: set where a < b.
+    const Block difference = (a | HIGH_BITS) - (b & LOW_BITS);
+    const Block borrow = ((~a & b) | (~(a ^ b) & ~difference)) & HIGH_BITS;
+    const Block b_is_greater = byteMask(borrow);
+    return (a & ~b_is_greater) | (b & b_is_greater);
+  }
+#endif
+};
+
+/**
+ * blend8 works out as (a * (256 - amount) + b * (1 + amount)) >> 8, which
+ * never exceeds 16 bits.
+ */
+struct Blend {
+  static uint8_t byte(uint8_t a, uint8_t b, uint8_t amount) {
+    return blend8(a, b, amount);
+  }
+
+#if defined(FRAMEBUFFER_SSE2)
+  static Block block(Block a, Block b, uint8_t amount) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i keep = _mm_set1_epi16(256 - amount);
+    const __m128i take = _mm_set1_epi16((uint16_t) amount + 1);
+    __m128i lo = _mm_add_epi16(
+        _mm_mullo_epi16(_mm_unpacklo_epi8(a, zero), keep),
+        _mm_mullo_epi16(_mm_unpacklo_epi8(b, zero), take));
+    __m128i hi = _mm_add_epi16(
+        _mm_mullo_epi16(_mm_unpackhi_epi8(a, zero), keep),
+        _mm_mullo_epi16(_mm_unpackhi_epi8(b, zero), take));
+    return _mm_packus_epi16(_mm_srli_epi16(lo, 8), _mm_srli_epi16(hi, 8));
+  }
+#elif defined(FRAMEBUFFER_SWAR)
+  static Block block(Block a, Block b, uint8_t amount) {
+    const Block keep = 256 - (Block) amount;
+    const Block take = (Block) amount + 1;
+    const Block even = (((a & EVEN_BYTES) * keep + (b & EVEN_BYTES) * take) >> 8) & EVEN_BYTES;
+    const Block odd = (((a >> 8) & EVEN_BYTES) * keep + ((b >> 8) & EVEN_BYTES) * take) & ODD_BYTES;
+    return even | odd;
+  }
+#endif
+};
+
+/**
+ * Apply Op to each byte of dst, paired with the same byte of src.
+ */
+template <typename Op>
+void apply(uint8_t* dst, const uint8_t* src, uint16_t bytes, uint8_t param) {
+  uint16_t i = 0;
+#if defined(FRAMEBUFFER_SSE2) || defined(FRAMEBUFFER_SWAR)
+  for (; i + sizeof(Block) <= bytes; i += sizeof(Block)) {
+    store(dst + i, Op::block(load(dst + i), load(src + i), param));
+  }
+#endif
+  for (; i < bytes; i++) {
+    dst[i] = Op::byte(dst[i], src[i], param);
+  }
+}
+
+/**
+ * Apply Op to each byte of leds, paired with the matching channel of color.
+ */
+template <typename Op>
+void applyColor(CRGB leds[], uint16_t count, const CRGB& color, uint8_t param) {
+#if defined(FRAMEBUFFER_SSE2) || defined(FRAMEBUFFER_SWAR)
+  uint8_t pattern[PATTERN_BYTES];
+  for (uint8_t i = 0; i < PATTERN_PIXELS; i++) {
+    memcpy(pattern + (i * 3), color.raw, 3);
+  }
+
+  uint8_t* dst = (uint8_t*) leds;
+  uint16_t bytes = count * 3;
+  while (bytes >= PATTERN_BYTES) {
+    apply<Op>(dst, pattern, PATTERN_BYTES, param);
+    dst += PATTERN_BYTES;
+    bytes -= PATTERN_BYTES;
+  }
+  apply<Op>(dst, pattern, bytes, param);
+#else
+  for (uint16_t i = 0; i < count; i++) {
+    leds[i].r = Op::byte(leds[i].r, color.r, param);
+    leds[i].g = Op::byte(leds[i].g, color.g, param);
+    leds[i].b = Op::byte(leds[i].b, color.b, param);
+  }
+#endif
+}
+
+}  // namespace
+
+void scale(CRGB leds[], uint16_t count, uint8_t scale) {
+#if defined(FRAMEBUFFER_SSE2) || defined(FRAMEBUFFER_SWAR)
+  uint8_t* bytes = (uint8_t*) leds;
+  apply<Scale>(bytes, bytes, count * 3, scale);
+#else
+  nscale8(leds, count, scale);
+#endif
+}
+
+void fade(CRGB leds[], uint16_t count, uint8_t fade_by) {
+  scale(leds, count, 255 - fade_by);
+}
+
+void add(CRGB leds[], uint16_t count, const CRGB& color) {
+  applyColor<Add>(leds, count, color, 0);
+}
+
+void lighten(CRGB leds[], uint16_t count, const CRGB& color) {
+  applyColor<Lighten>(leds, count, color, 0);
+}
+
+void blendToward(CRGB leds[], uint16_t count, const CRGB& color, fract8 amount) {
+  if (amount == 0) return;
+  applyColor<Blend>(leds, count, color, amount);
+}
+
+void blend(CRGB dst[], const CRGB src[], uint16_t count, fract8 amount) {
+  if (amount == 0) return;
+  apply<Blend>((uint8_t*) dst, (const uint8_t*) src, count * 3, amount);
+}
+
+}  // namespace framebuffer
+FASTLED_NAMESPACE_END
@@ -0,0 +1,45 @@
+/** @file
+ * Bulk operations over a buffer of CRGB pixels.
+ *
+ * Each function gives exactly the same result as applying the equivalent
+ * FastLED primitive to every pixel in turn, but works on several channel
+ * bytes at once where the platform allows it:
+ * - SSE2 hosts: 16 bytes per operation.
+ * - ARM and other 32-bit targets: 4 bytes per operation, packed into a
+ *   uint32_t (SWAR - SIMD within a register).
+ * - AVR: registers are only 8 bits wide so packing gains nothing; FastLED's
+ *   own per-byte assembly is used instead.
+ */
+#define FASTLED_INTERNAL  // Disable pragma version message on compilation
+#ifndef FRAMEBUFFER_H
+#define FRAMEBUFFER_H
+#include <FastLED.h>
+#include <stdint.h>
+
+FASTLED_USING_NAMESPACE
+
+namespace framebuffer {
+
+/// Same as nscale8(leds, count, scale).
+void scale(CRGB leds[], uint16_t count, uint8_t scale);
+
+/// Same as fadeToBlackBy(leds, count, fade_by).
+void fade(CRGB leds[], uint16_t count, uint8_t fade_by);
+
+/// Same as `leds[i] += color` for every pixel.
+void add(CRGB leds[], uint16_t count, const CRGB& color);
+
+/// Same as `leds[i] |= color` for every pixel.
+void lighten(CRGB leds[], uint16_t count, const CRGB& color);
+
+/// Same as `nblend(leds[i], color, amount)` for every pixel.
+void blendToward(CRGB leds[], uint16_t count, const CRGB& color, fract8 amount);
+
+/// Same as `nblend(dst[i], src[i], amount)` for every pixel.
+void blend(CRGB dst[], const CRGB src[], uint16_t count, fract8 amount);
+
+}  // namespace framebuffer
+
+FASTLED_NAMESPACE_END
+
+#endif
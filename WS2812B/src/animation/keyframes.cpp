@@ -0,0 +1,71 @@
+/** @file */
+#include "keyframes.h"
+#include "framebuffer.h"
+
+FASTLED_USING_NAMESPACE
+namespace keyframes {
+
+#ifdef KEYFRAME_INTERPOLATION
+/**
+ * The latest keyframe for one strip configuration.
+ */
+template <typename Strip>
+struct Keyframe {
+  CRGB leds_[Strip::CAPACITY];
+  Animation animation_ = nullptr;   ///< The animation that rendered leds_
+  uint8_t frames_remaining_ = 0;    ///< Frames until the output reaches leds_
+};
+
+template <typename Strip>
+static Keyframe<Strip>& latest(void) {
+  static Keyframe<Strip> keyframe;
+  return keyframe;
+}
+
+template <typename Strip>
+void render(CRGB leds[], Animation animation, uint8_t keyframe_interval) {
+  Keyframe<Strip>& keyframe = latest<Strip>();
+
+  if (keyframe_interval <= 1) {
+    animation(leds);
+    keyframe.animation_ = nullptr;
+    return;
+  }
+
+  // Changing animation renders a keyframe straight away, so the switch
+  // becomes a short crossfade.
+  if (keyframe.frames_remaining_ == 0 || animation != keyframe.animation_) {
+    animation(keyframe.leds_);
+    keyframe.animation_ = animation;
+    keyframe.frames_remaining_ = keyframe_interval;
+  }
+
+  // Cover 1/frames_remaining_ of the remaining distance each frame, which
+  // arrives at the keyframe exactly when frames_remaining_ reaches 1.
+  framebuffer::blend(leds, keyframe.leds_, Strip::LENGTH, (256 / keyframe.frames_remaining_) - 1);
+  keyframe.frames_remaining_--;
+}
+
+template <typename Strip>
+void reset(void) {
+  latest<Strip>().animation_ = nullptr;
+  latest<Strip>().frames_remaining_ = 0;
+}
+#else
+template <typename Strip>
+void render(CRGB leds[], Animation animation, uint8_t /* keyframe_interval */) {
+  animation(leds);
+}
+
+template <typename Strip>
+void reset(void) {}
+#endif
+
+#define INSTANTIATE_KEYFRAMES(STRIP) \
+  template void render<STRIP>(CRGB leds[], Animation, uint8_t); \
+  template void reset<STRIP>(void);
+FOR_EACH_STRIP(INSTANTIATE_KEYFRAMES)
+#undef INSTANTIATE_KEYFRAMES
+
+}  // namespace keyframes
+FASTLED_NAMESPACE_END
@@ -0,0 +1,45 @@
+/** @file
+ * Keyframe rendering for smooth animations.
+ *
+ * Animations whose content changes slowly from one frame to the next can be
+ * rendered every few frames into a keyframe buffer. The frames in between
+ * move the LEDs linearly toward the latest keyframe, which is much cheaper
+ * than rendering.
+ */
+#define FASTLED_INTERNAL  // Disable pragma version message on compilation
+#ifndef KEYFRAMES_H
+#define KEYFRAMES_H
+#include <FastLED.h>
+#include "../../hardware-config.h"
+#include "strip.h"
+
+FASTLED_USING_NAMESPACE
+
+namespace keyframes {
+
+typedef void (*Animation)(CRGB leds[]);
+
+/**
+ * Render animation into leds, a strip described by Strip, fully rendering it only once every
+ * keyframe_interval frames and interpolating the rest.
+ *
+ * A keyframe_interval of 1 renders every frame, as does building without
+ * KEYFRAME_INTERPOLATION. Animations that read back the previous frame, such
+ * as those using FADE, should always use 1.
+ */
+template <typename Strip>
+void render(CRGB leds[], Animation animation, uint8_t keyframe_interval);
+
+/**
+ * Forget the latest keyframe for Strip, so that the next render() starts
+ * from a freshly rendered one. Call it whenever something other than
+ * render() has drawn into the LEDs, e.g. after a mode change.
+ */
+template <typename Strip>
+void reset(void);
+
+}  // namespace keyframes
+
+FASTLED_NAMESPACE_END
+
+#endif
@@ -0,0 +1,68 @@
+/** @file
+ * 2D versions of strip animations for LED panels: strip configurations
+ * whose Layout is a layout::Matrix.
+ */
+#include <FastLED.h>
+#include "animations.h"
+
+FASTLED_USING_NAMESPACE
+namespace animations {
+namespace {
+
+/// The panel layout of Strip, which must have an LED for every pixel of the panel.
+template <typename Strip>
+struct PanelOf {
+  typedef typename Strip::Layout Layout;
+  static_assert(Layout::COUNT <= Strip::CAPACITY, "The strip has fewer LEDs than its panel layout");
+};
+
+}  // namespace
+
+template <typename Strip>
+void matrixFlow(CRGB leds[]) {
+  // paletteFlow, with each row starting a little further along the palette
+  // so the colors move diagonally.
+  typedef typename PanelOf<Strip>::Layout Panel;
+  for (uint8_t y = 0; y < Panel::HEIGHT; y++) {
+    const typename Panel::LedIndex* row = Panel::row(y);
+    uint8_t color_index = hue_ + (y * 8);
+    for (uint8_t x = 0; x < Panel::WIDTH; x++) {
+      leds[Panel::read(row + x)] = ColorFromPalette(palette_, color_index, 240, LINEARBLEND);
+      color_index += 15;
+    }
+  }
+}
+
+template <typename Strip>
+void matrixSinelon(CRGB leds[]) {
+  // a colored dot tracing a Lissajous curve, with fading trails
+  typedef typename PanelOf<Strip>::Layout Panel;
+  FADE(20);
+  const uint8_t x = beatsin8(13, 0, Panel::WIDTH - 1);
+  const uint8_t y = beatsin8(9, 0, Panel::HEIGHT - 1);
+  leds[Panel::XY(x, y)] += CHSV(hue_, 255, 192);
+}
+
+template <typename Strip>
+void matrixJuggle(CRGB leds[]) {
+  // eight colored dots, weaving in and out of sync with each other
+  typedef typename PanelOf<Strip>::Layout Panel;
+  FADE(20);
+  uint8_t dothue = 0;
+  for (uint8_t i = 0; i < 8; i++) {
+    const uint8_t x = beatsin8(i + 7, 0, Panel::WIDTH - 1);
+    const uint8_t y = beatsin8(i + 5, 0, Panel::HEIGHT - 1);
+    leds[Panel::XY(x, y)] |= CHSV(dothue, 200, 255);
+    dothue += 32;
+  }
+}
+
+#define INSTANTIATE_ANIMATIONS(STRIP) \
+  template void matrixFlow<STRIP>(CRGB leds[]); \
+  template void matrixSinelon<STRIP>(CRGB leds[]); \
+  template void matrixJuggle<STRIP>(CRGB leds[]);
+FOR_EACH_PANEL(INSTANTIATE_ANIMATIONS)
+#undef INSTANTIATE_ANIMATIONS
+
+}  // namespace animations
+FASTLED_NAMESPACE_END
@@ -7,40 +7,51 @@ namespace animations {
 
 CHSV static_color_hsv_ = CHSV(0, 0, 0);
 
+template <typename Strip>
 void monochromeJuggle(CRGB leds[]) {
   // four colored dots, weaving in and out of sync with each other
   FADE(20);
   for (int i = 0; i < 3; i++) {
-    leds[beatsin16(i + 4, 0, NUM_LEDS - 1)] |= CHSV(
+    leds[beatsin16(i + 4, 0, Strip::LENGTH - 1)] |= CHSV(
         static_color_hsv_.hue, static_color_hsv_.sat, static_color_hsv_.val);
   }
 }
 
+template <typename Strip>
 void monochromeGlitter(CRGB leds[]) {
   FADE(3);
   if (random8() < CHANCE_OF_GLITTER) {
-    leds[random16(NUM_LEDS)] += static_color_hsv_;
+    leds[random16(Strip::LENGTH)] += static_color_hsv_;
   }
 }
 
+template <typename Strip>
 void monochromeSinelon(CRGB leds[]) {
   // Similar to animationSinelon but all lights stay on at a low level
   // with the sweep 'overlayed'
   FADE(5);
-  for (int i = 0; i < NUM_LEDS; i++) {
-    leds[i] |= CHSV(static_color_hsv_.hue, static_color_hsv_.sat, 60);
-  }
+  framebuffer::lighten(leds, Strip::LENGTH, CHSV(static_color_hsv_.hue, static_color_hsv_.sat, 60));
   for (int i = 0; i < 1; i++) {  // i = number of fliers
-    leds[beatsin16((i + 3) * animation_speed_multiplier_, 0, NUM_LEDS - 1)] |= static_color_hsv_;
+    // In 8.8 fixed point, as slow speeds are below 1 BPM.
+    leds[beatsin88((i + 3) * animation_speed_multiplier_ * 256, 0, Strip::LENGTH - 1)] |= static_color_hsv_;
   }
 }
 
+template <typename Strip>
 void monochromePulse(CRGB leds[]) {
   // Pulse the brightness of all lights together
-  fill_solid(leds, NUM_LEDS,
+  fill_solid(leds, Strip::LENGTH,
              CHSV(static_color_hsv_.hue, static_color_hsv_.sat,
                   beatsin16(30 * animation_speed_multiplier_, 120, 255)));
 }
 
+#define INSTANTIATE_ANIMATIONS(STRIP) \
+  template void monochromeJuggle<STRIP>(CRGB leds[]); \
+  template void monochromeGlitter<STRIP>(CRGB leds[]); \
+  template void monochromeSinelon<STRIP>(CRGB leds[]); \
+  template void monochromePulse<STRIP>(CRGB leds[]);
+FOR_EACH_STRIP(INSTANTIATE_ANIMATIONS)
+#undef INSTANTIATE_ANIMATIONS
+
 }  // namespace animations
 FASTLED_NAMESPACE_END
@@ -0,0 +1,213 @@
+/** @file
+ * Organic effects built on noise: fire, clouds and aurora.
+ *
+ * Evaluating inoise8 for every LED on every frame is too slow on an Uno, so
+ * each octave of noise is only evaluated at lattice points a few LEDs apart
+ * and LEDs interpolate between their neighbouring points. Each frame only a
+ * few lattice points are re-evaluated, round-robin. When the field scrolls
+ * past a lattice point, only the newly exposed point is evaluated.
+ */
+#include <FastLED.h>
+#include <string.h>
+#include "animations.h"
+
+FASTLED_USING_NAMESPACE
+namespace animations {
+namespace {
+
+/**
+ * One octave of noise along a strip of up to CAPACITY LEDs, cached at
+ * lattice points 2^SPACING_SHIFT LEDs apart.
+ *
+ * Positions along the strip are in 1/256ths of an LED.
+ */
+template <uint16_t CAPACITY, uint8_t SPACING_SHIFT, uint8_t REFRESH_PER_FRAME>
+class NoiseOctave {
+ public:
+  /// Enough points to cover the strip at any scroll offset.
+  static const uint16_t POINTS = ((CAPACITY - 1) >> SPACING_SHIFT) + 3;
+
+  /// Distance between lattice points in inoise8 coordinates.
+  static const uint8_t X_STEP = 128;
+
+  /// Evaluate every lattice point.
+  void reset(const uint32_t scroll, const uint16_t time) {
+    origin_ = scroll >> (8 + SPACING_SHIFT);
+    for (uint16_t i = 0; i < POINTS; i++) {
+      samples_[i] = evaluate(i, time);
+    }
+    cursor_ = 0;
+  }
+
+  /// Follow the scroll position and re-evaluate the next few lattice points.
+  void update(const uint32_t scroll, const uint16_t time) {
+    const uint16_t origin = scroll >> (8 + SPACING_SHIFT);
+    while (origin_ != origin) {
+      memmove(samples_, samples_ + 1, POINTS - 1);
+      origin_++;
+      samples_[POINTS - 1] = evaluate(POINTS - 1, time);
+    }
+
+    for (uint8_t n = 0; n < REFRESH_PER_FRAME; n++) {
+      samples_[cursor_] = evaluate(cursor_, time);
+      if (++cursor_ == POINTS) {
+        cursor_ = 0;
+      }
+    }
+  }
+
+  /// Prepare to read the value for each LED in turn with next().
+  void start(const uint32_t scroll) {
+    walk_sample_ = samples_;
+    walk_position_ = (scroll >> SPACING_SHIFT) & 0xFF;
+  }
+
+  /// Interpolated value for the next LED.
+  uint8_t next(void) {
+    const uint8_t value = lerp8by8(walk_sample_[0], walk_sample_[1], walk_position_);
+    walk_position_ += 256 >> SPACING_SHIFT;
+    if (walk_position_ > 0xFF) {
+      walk_position_ -= 256;
+      walk_sample_++;
+    }
+    return value;
+  }
+
+ private:
+  uint8_t samples_[POINTS];
+  uint16_t origin_ = 0;   ///< Lattice index of samples_[0]
+  uint16_t cursor_ = 0;   ///< Next point to re-evaluate
+
+  const uint8_t* walk_sample_ = samples_;
+  uint16_t walk_position_ = 0;  ///< Position between walk_sample_[0] and [1], in 1/256ths
+
+  uint8_t evaluate(const uint16_t point, const uint16_t time) const {
+    return inoise8((origin_ + point) * X_STEP, time);
+  }
+};
+
+/**
+ * Two octaves of noise with their own scroll position and time.
+ */
+template <uint16_t CAPACITY>
+class NoiseField {
+ public:
+  /// Large features, 16 LEDs between points, which change slowly.
+  NoiseOctave<CAPACITY, 4, 1> coarse_;
+
+  /// Small features, 4 LEDs between points.
+  NoiseOctave<CAPACITY, 2, 6> fine_;
+
+  /**
+   * Move the noise field along and bring the caches up to date.
+   *
+   * @param animation    The animation being drawn. Switching animation fills the caches from scratch.
+   * @param scroll_speed LED positions per frame, in 1/256ths of an LED, at normal speed.
+   * @param time_speed   Change in the noise per frame, at normal speed.
+   */
+  void update(void (*animation)(CRGB leds[]), const uint8_t scroll_speed, const uint8_t time_speed) {
+    advance(scroll_, scroll_fraction_, scroll_speed);
+    advance(time_, time_fraction_, time_speed);
+
+    // The coarse octave also changes more slowly over time. Both times wrap
+    // at 65536 like inoise8's own coordinates, so neither jumps when time_
+    // overflows 16 bits.
+    const uint16_t coarse_time = time_ >> 2;
+    const uint16_t fine_time = time_;
+    if (animation != animation_) {
+      animation_ = animation;
+      coarse_.reset(scroll_, coarse_time);
+      fine_.reset(scroll_, fine_time);
+    }
+    else {
+      coarse_.update(scroll_, coarse_time);
+      fine_.update(scroll_, fine_time);
+    }
+
+    coarse_.start(scroll_);
+    fine_.start(scroll_);
+  }
+
+  /// Sum of both octaves for the next LED, weighted toward the coarse one.
+  uint8_t next(void) {
+    return scale8(coarse_.next(), 170) + scale8(fine_.next(), 85);
+  }
+
+ private:
+  uint32_t scroll_ = 0;
+  uint32_t time_ = 0;
+  void (*animation_)(CRGB leds[]) = nullptr;  ///< Animation that last updated the caches
+
+  // Fractions of a step carried over to the next frame, in 1/256ths, so
+  // that slow speeds still move.
+  uint8_t scroll_fraction_ = 0;
+  uint8_t time_fraction_ = 0;
+
+  /// Move position on by speed times animation_speed_multiplier_, keeping the fraction for next time.
+  template <typename Position>
+  static void advance(Position& position, uint8_t& fraction, const uint8_t speed) {
+    const uint32_t step = (uint32_t) (speed * animation_speed_multiplier_ * 256) + fraction;
+    position += step >> 8;
+    fraction = step & 0xFF;
+  }
+};
+
+/// Each strip configuration keeps its own noise field.
+template <typename Strip>
+NoiseField<Strip::CAPACITY>& noiseField(void) {
+  static NoiseField<Strip::CAPACITY> field;
+  return field;
+}
+
+}  // namespace
+
+template <typename Strip>
+void noiseFire(CRGB leds[]) {
+  // Flames rise from the first LED and cool toward the far end.
+  NoiseField<Strip::CAPACITY>& noise = noiseField<Strip>();
+  noise.update(noiseFire<Strip>, 96, 12);
+
+  // The noise field scrolls toward its start, so walk it from the far end
+  // of the strip to make the flames move up.
+  const uint16_t cooling_step = (255U << 8) / Strip::LENGTH;
+  uint16_t heat_limit = 0;
+  for (int i = Strip::LENGTH - 1; i >= 0; i--) {
+    heat_limit += cooling_step;
+    const uint8_t heat = scale8(noise.next(), heat_limit >> 8);
+    leds[i] = ColorFromPalette(palette_, heat, qadd8(heat, heat), LINEARBLEND);
+  }
+}
+
+template <typename Strip>
+void noiseClouds(CRGB leds[]) {
+  // Soft patches of color that drift and billow slowly.
+  NoiseField<Strip::CAPACITY>& noise = noiseField<Strip>();
+  noise.update(noiseClouds<Strip>, 16, 4);
+  for (int i = 0; i < Strip::LENGTH; i++) {
+    leds[i] = ColorFromPalette(palette_, hue_ + noise.next(), 240, LINEARBLEND);
+  }
+}
+
+template <typename Strip>
+void noiseAurora(CRGB leds[]) {
+  // Broad bands of color from the coarse octave, with bright curtains from
+  // the fine octave.
+  NoiseField<Strip::CAPACITY>& noise = noiseField<Strip>();
+  noise.update(noiseAurora<Strip>, 40, 8);
+  for (int i = 0; i < Strip::LENGTH; i++) {
+    const uint8_t color = noise.coarse_.next();
+    const uint8_t curtain = noise.fine_.next();
+    const uint8_t brightness = qadd8(scale8(curtain, curtain), 32);
+    leds[i] = ColorFromPalette(palette_, hue_ + color, brightness, LINEARBLEND);
+  }
+}
+
+#define INSTANTIATE_ANIMATIONS(STRIP) \
+  template void noiseFire<STRIP>(CRGB leds[]); \
+  template void noiseClouds<STRIP>(CRGB leds[]); \
+  template void noiseAurora<STRIP>(CRGB leds[]);
+FOR_EACH_STRIP(INSTANTIATE_ANIMATIONS)
+#undef INSTANTIATE_ANIMATIONS
+
+}  // namespace animations
+FASTLED_NAMESPACE_END
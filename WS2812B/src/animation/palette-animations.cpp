@@ -7,20 +7,30 @@ namespace animations {
 
 CRGBPalette16 palette_;
 
+template <typename Strip>
 void paletteFlow(CRGB leds[]) {
-    fill_palette(leds, NUM_LEDS, hue_, 15, palette_, 240, LINEARBLEND);
+    fill_palette(leds, Strip::LENGTH, hue_, 15, palette_, 240, LINEARBLEND);
 }
 
+template <typename Strip>
 void paletteFlowWithGlitter(CRGB leds[]) {
-    fill_palette(leds, NUM_LEDS, hue_, 15, palette_, 240, LINEARBLEND);
-    addGlitter(leds);
+    fill_palette(leds, Strip::LENGTH, hue_, 15, palette_, 240, LINEARBLEND);
+    addGlitter<Strip>(leds);
 }
 
+template <typename Strip>
 void paletteGlitter(CRGB leds[]) {
     FADE(3);
     if (random8() < CHANCE_OF_GLITTER) {
-        leds[random16(NUM_LEDS)] += ColorFromPalette(palette_, random8());
+        leds[random16(Strip::LENGTH)] += ColorFromPalette(palette_, random8());
     }
 }
 
+#define INSTANTIATE_ANIMATIONS(STRIP) \
+  template void paletteFlow<STRIP>(CRGB leds[]); \
+  template void paletteFlowWithGlitter<STRIP>(CRGB leds[]); \
+  template void paletteGlitter<STRIP>(CRGB leds[]);
+FOR_EACH_STRIP(INSTANTIATE_ANIMATIONS)
+#undef INSTANTIATE_ANIMATIONS
+
 }
@@ -0,0 +1,76 @@
+/** @file
+ * Compact per-pixel state for animations that need to remember something
+ * about each LED between frames.
+ */
+#ifndef PIXEL_STATE_H
+#define PIXEL_STATE_H
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * One byte of state per LED, split into fixed-width fields:
+ * - bits 0-3: phase, 0 meaning idle.
+ * - bits 4-5: speed class.
+ * - bits 6-7: color variant.
+ *
+ * advance() updates every LED of one speed class at once, four LEDs per
+ * 32-bit operation. AVR has no 32-bit registers to gain from this, so it
+ * takes one LED at a time, as in framebuffer.cpp.
+ */
+template <uint16_t COUNT>
+class PackedPixelState {
+ public:
+  static const uint8_t PHASES = 16;
+  static const uint8_t SPEEDS = 4;
+  static const uint8_t COLORS = 4;
+
+  PackedPixelState() { clear(); }
+
+  void clear(void) { memset(state_, 0, sizeof(state_)); }
+
+  uint8_t phase(uint16_t i) const { return state_[i] & 0x0F; }
+  uint8_t speed(uint16_t i) const { return (state_[i] >> 4) & 0x03; }
+  uint8_t color(uint16_t i) const { return state_[i] >> 6; }
+
+  void set(uint16_t i, uint8_t phase, uint8_t speed, uint8_t color) {
+    state_[i] = (phase & 0x0F) | ((speed & 0x03) << 4) | (color << 6);
+  }
+
+  /**
+   * Move every active LED in the given speed class on to its next phase.
+   * LEDs that pass the last phase become idle.
+   */
+  void advance(uint8_t speed) {
+    speed &= 0x03;
+    uint16_t i = 0;
+    #ifndef __AVR__
+    const uint32_t target = speed * 0x01010101UL;
+    for (; i + 4 <= COUNT; i += 4) {
+      uint32_t word;
+      memcpy(&word, state_ + i, 4);
+
+      // Low bit of each byte set where speed matches and phase is non-zero.
+      const uint32_t speeds = ((word >> 4) & 0x03030303UL) ^ target;
+      const uint32_t speed_matches = ~(speeds | (speeds >> 1)) & 0x01010101UL;
+      const uint32_t phases = word & 0x0F0F0F0FUL;
+      const uint32_t active = (phases | (phases >> 1) | (phases >> 2) | (phases >> 3)) & 0x01010101UL;
+
+      // Phase 15 + 1 carries into bit 4, which the mask drops: back to idle.
+      const uint32_t next_phases = (phases + (speed_matches & active)) & 0x0F0F0F0FUL;
+      word = (word & 0xF0F0F0F0UL) | next_phases;
+      memcpy(state_ + i, &word, 4);
+    }
+    #endif
+    for (; i < COUNT; i++) {
+      const uint8_t state = state_[i];
+      if ((state & 0x0F) != 0 && ((state >> 4) & 0x03) == speed) {
+        state_[i] = (state & 0xF0) | ((state + 1) & 0x0F);
+      }
+    }
+  }
+
+ private:
+  uint8_t state_[COUNT];
+};
+
+#endif
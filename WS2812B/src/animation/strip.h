@@ -0,0 +1,94 @@
+/** @file
+ * Compile-time descriptions of LED strips for the animation templates.
+ *
+ * Animations are templates on a strip configuration rather than reading
+ * NUM_LEDS directly, so that each fixture gets loops with constant bounds
+ * and several fixtures can share one build. Each configuration provides:
+ * - LENGTH: number of LEDs to draw.
+ * - CAPACITY: compile-time upper bound on LENGTH, used to size per-LED state.
+ * - ORDER: color order of the LEDs, for FastLED.addLeds().
+ * - Layout: how the LEDs are arranged, e.g. a layout::Matrix for a 2D panel,
+ *   or NoLayout for a plain strip.
+ */
+#define FASTLED_INTERNAL  // Disable pragma version message on compilation
+#ifndef STRIP_H
+#define STRIP_H
+#include <FastLED.h>
+#include <stdint.h>
+#include "../../hardware-config.h"
+#include "../layout/layout.h"
+
+FASTLED_USING_NAMESPACE
+
+namespace animations {
+
+/// Layout of a strip that is not arranged as a 2D panel.
+struct NoLayout {};
+
+/**
+ * A strip whose length is fixed at compile time.
+ */
+template <uint16_t LENGTH_, EOrder ORDER_ = GRB, typename LAYOUT_ = NoLayout>
+struct StripConfig {
+  static const uint16_t LENGTH = LENGTH_;
+  static const uint16_t CAPACITY = LENGTH_;
+  static const EOrder ORDER = ORDER_;
+  typedef LAYOUT_ Layout;
+};
+
+/**
+ * A strip whose length is set at runtime, up to CAPACITY. One instantiation
+ * serves every length, at the cost of variable loop bounds.
+ *
+ * LENGTH, and any state an animation keeps per strip configuration (noise
+ * caches, twinkle state, keyframes), belong to the type rather than to a
+ * fixture. Fixtures sharing one DynamicStripConfig therefore share that
+ * state and must not be drawn in the same frame with different lengths.
+ */
+template <uint16_t CAPACITY_, EOrder ORDER_ = GRB>
+struct DynamicStripConfig {
+  static uint16_t LENGTH;
+  static const uint16_t CAPACITY = CAPACITY_;
+  static const EOrder ORDER = ORDER_;
+  typedef NoLayout Layout;
+};
+
+template <uint16_t CAPACITY_, EOrder ORDER_>
+uint16_t DynamicStripConfig<CAPACITY_, ORDER_>::LENGTH = CAPACITY_;
+
+#ifdef MATRIX_WIDTH
+/// The panel described by hardware-config.h.
+typedef StripConfig<NUM_LEDS, COLOR_ORDER, layout::Panel> MainStrip;
+#else
+/// The strip described by hardware-config.h.
+typedef StripConfig<NUM_LEDS, COLOR_ORDER> MainStrip;
+#endif
+
+/**
+ * Every strip configuration that the animations are compiled for. Define
+ * it before including this header, e.g. with the compiler's -include, to
+ * add a configuration for each extra fixture driven by this build.
+ */
+#ifndef FOR_EACH_STRIP
+#define FOR_EACH_STRIP(X) \
+  X(animations::MainStrip)
+#endif
+
+/**
+ * The configurations from FOR_EACH_STRIP with a layout::Matrix Layout, for
+ * which the 2D matrix animations are also compiled.
+ */
+#ifndef FOR_EACH_PANEL
+#ifdef MATRIX_WIDTH
+#define FOR_EACH_PANEL(X) \
+  X(animations::MainStrip)
+#else
+#define FOR_EACH_PANEL(X)
+#endif
+#endif
+
+}  // namespace animations
+
+FASTLED_NAMESPACE_END
+
+#endif
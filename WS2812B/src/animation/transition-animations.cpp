@@ -5,20 +5,22 @@
 namespace animations {
 uint8_t transition_progress_ = 0;
 
+template <typename Strip>
 void transitionFadeToSolid(CRGB leds[], CRGB target_color) {
   CRGB blended = nblend(leds[0], target_color, transition_progress_);
-  for (int i = 0; i < NUM_LEDS; i++) {
+  for (int i = 0; i < Strip::LENGTH; i++) {
     leds[i] = blended;
   }
   transition_progress_ = qadd8(transition_progress_, 1);
 }
 
+template <typename Strip>
 void transitionLinearToSolid(CRGB leds[], CRGB target_color) {
   // CRGB blended = nblend(leds[0], target_color, transition_progress_);
-  // uint16_t limit = beatsin16(20, 0, NUM_LEDS);
+  // uint16_t limit = beatsin16(20, 0, Strip::LENGTH);
 
-  int limit = map(transition_progress_, 0, 255, 0, NUM_LEDS);
-  for (int i = 0; i < NUM_LEDS; i++) {
+  int limit = map(transition_progress_, 0, 255, 0, Strip::LENGTH);
+  for (int i = 0; i < Strip::LENGTH; i++) {
     if (i <= limit) {
       leds[i] = target_color;
     }
@@ -26,4 +28,10 @@ void transitionLinearToSolid(CRGB leds[], CRGB target_color) {
   transition_progress_ = qadd8(transition_progress_, 5);
 }
 
+#define INSTANTIATE_ANIMATIONS(STRIP) \
+  template void transitionFadeToSolid<STRIP>(CRGB leds[], CRGB); \
+  template void transitionLinearToSolid<STRIP>(CRGB leds[], CRGB);
+FOR_EACH_STRIP(INSTANTIATE_ANIMATIONS)
+#undef INSTANTIATE_ANIMATIONS
+
 }  // namespace animations
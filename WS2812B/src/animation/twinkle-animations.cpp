@@ -0,0 +1,133 @@
+/** @file
+ * Twinkling effects where each LED fades in and out independently, at its
+ * own speed and in its own color.
+ */
+#include <FastLED.h>
+#include "animations.h"
+#include "pixel-state.h"
+
+FASTLED_USING_NAMESPACE
+namespace animations {
+namespace {
+
+/// Frames per phase for the fastest speed class; each class is half as fast as the previous.
+#define TWINKLE_FASTEST_SHIFT 2
+
+/// Chance (out of 256) each frame of starting a new twinkle, per 32 LEDs.
+#define TWINKLE_SPAWN_CHANCE 8
+
+/// Triangle wave over the phases of a twinkle, peaking halfway.
+uint8_t phaseLevel(const uint8_t phase) {
+  const uint16_t level = phase <= 8 ? phase * 32 : (16 - phase) * 32;
+  return level > 255 ? 255 : level;
+}
+
+/**
+ * The state of every twinkle on one strip configuration.
+ */
+template <typename Strip>
+class Twinkles {
+ public:
+  typedef PackedPixelState<Strip::CAPACITY> State;
+
+  State state_;
+
+  /**
+   * Move all twinkles on by one frame and start some new ones.
+   */
+  void update(void) {
+    frame_++;
+    for (uint8_t speed = 0; speed < State::SPEEDS; speed++) {
+      const uint16_t period_mask = (1 << (TWINKLE_FASTEST_SHIFT + speed)) - 1;
+      if ((frame_ & period_mask) == 0) {
+        state_.advance(speed);
+      }
+    }
+
+    for (uint16_t n = 0; n < Strip::LENGTH / 32 + 1; n++) {
+      if (random8() < TWINKLE_SPAWN_CHANCE) {
+        const uint16_t i = random16(Strip::LENGTH);
+        if (state_.phase(i) == 0) {
+          state_.set(i, 1, random8(State::SPEEDS), random8(State::COLORS));
+        }
+      }
+    }
+  }
+
+  /**
+   * Brightness of LED i, interpolated between its current and next phase so
+   * that slow twinkles stay smooth.
+   */
+  uint8_t brightness(const uint16_t i) const {
+    const uint8_t phase = state_.phase(i);
+    if (phase == 0) {
+      return 0;
+    }
+    const uint8_t shift = TWINKLE_FASTEST_SHIFT + state_.speed(i);
+    const uint8_t progress = (frame_ << (8 - shift)) & 0xFF;
+    const uint8_t level = lerp8by8(phaseLevel(phase), phaseLevel((phase + 1) & 0x0F), progress);
+    return scale8(level, level);  // Steeper curve so twinkles read as sparkles
+  }
+
+ private:
+  uint16_t frame_ = 0;
+};
+
+/// Each strip configuration keeps its own twinkles.
+template <typename Strip>
+Twinkles<Strip>& twinklesFor(void) {
+  static Twinkles<Strip> twinkles;
+  return twinkles;
+}
+
+}  // namespace
+
+template <typename Strip>
+void twinkleFairyLights(CRGB leds[]) {
+  // Warm white bulbs glowing dimly, each occasionally brightening.
+  static const CRGB colors[] = {
+    CRGB::FairyLight,
+    CRGB::FairyLightNCC,
+    CRGB::OldLace,
+    CRGB::Gold,
+  };
+  Twinkles<Strip>& twinkles = twinklesFor<Strip>();
+  twinkles.update();
+  for (int i = 0; i < Strip::LENGTH; i++) {
+    leds[i] = colors[twinkles.state_.color(i)];
+    leds[i].nscale8_video(qadd8(twinkles.brightness(i), 24));
+  }
+}
+
+template <typename Strip>
+void twinkleMonochrome(CRGB leds[]) {
+  // Twinkles in the current static color, varying slightly in saturation.
+  Twinkles<Strip>& twinkles = twinklesFor<Strip>();
+  twinkles.update();
+  for (int i = 0; i < Strip::LENGTH; i++) {
+    leds[i] = CHSV(
+        static_color_hsv_.hue,
+        qsub8(static_color_hsv_.sat, twinkles.state_.color(i) * 32),
+        twinkles.brightness(i));
+  }
+}
+
+template <typename Strip>
+void twinklePalette(CRGB leds[]) {
+  // Twinkles in colors from each quarter of the current palette.
+  Twinkles<Strip>& twinkles = twinklesFor<Strip>();
+  twinkles.update();
+  for (int i = 0; i < Strip::LENGTH; i++) {
+    leds[i] = ColorFromPalette(palette_, hue_ + (twinkles.state_.color(i) << 6), twinkles.brightness(i), LINEARBLEND);
+  }
+}
+
+#define INSTANTIATE_ANIMATIONS(STRIP) \
+  template void twinkleFairyLights<STRIP>(CRGB leds[]); \
+  template void twinkleMonochrome<STRIP>(CRGB leds[]); \
+  template void twinklePalette<STRIP>(CRGB leds[]);
+FOR_EACH_STRIP(INSTANTIATE_ANIMATIONS)
+#undef INSTANTIATE_ANIMATIONS
+
+}  // namespace animations
+FASTLED_NAMESPACE_END
@@ -0,0 +1,54 @@
+/** @file */
+#include "adc-sampler.h"
+#include "../../hardware-config.h"
+
+#if defined(ADC_SAMPLER) && defined(MICROPHONE_PIN)
+#include <Arduino.h>
+
+namespace adc_sampler {
+
+volatile uint8_t samples_[AUDIO_SAMPLES];
+volatile uint8_t sample_count_ = AUDIO_SAMPLES;
+
+/// ADC enabled with the /128 prescaler, as set up by the Arduino core for analogRead().
+#define ADCSRA_ANALOG_READ (_BV(ADEN) | _BV(ADPS2) | _BV(ADPS1) | _BV(ADPS0))
+
+void start(uint8_t pin) {
+  if (pin >= A0) {
+    pin -= A0;  // Accept A1 as well as 1, like analogRead().
+  }
+  sample_count_ = 0;
+
+  // AVcc reference, result left-adjusted so that ADCH holds the top 8 bits.
+  ADMUX = _BV(REFS0) | _BV(ADLAR) | (pin & 0x07);
+  ADCSRB = 0;  // Free-running trigger
+  // Writing ADIF clears the flag left by the last analogRead(), which would
+  // otherwise fire the interrupt straight away with that reading.
+  ADCSRA = ADCSRA_ANALOG_READ | _BV(ADIF) | _BV(ADATE) | _BV(ADIE) | _BV(ADSC);
+}
+
+bool isFull(void) {
+  return sample_count_ >= AUDIO_SAMPLES;
+}
+
+void stop(void) {
+  ADCSRA = ADCSRA_ANALOG_READ;
+  // Let any conversion in progress finish so analogRead() starts cleanly.
+  while (ADCSRA & _BV(ADSC)) {
+  }
+}
+
+const volatile uint8_t* samples(void) {
+  return samples_;
+}
+
+}  // namespace adc_sampler
+
+ISR(ADC_vect) {
+  using namespace adc_sampler;
+  samples_[sample_count_] = ADCH;
+  if (++sample_count_ >= AUDIO_SAMPLES) {
+    ADCSRA = ADCSRA_ANALOG_READ;
+  }
+}
+#endif
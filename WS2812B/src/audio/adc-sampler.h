@@ -0,0 +1,41 @@
+/** @file
+ * Background sampling of the microphone on AVR boards.
+ *
+ * The ADC runs in free-running mode and its conversion-complete interrupt
+ * stores each reading, so a block of samples fills while the sketch waits
+ * between frames instead of busy-waiting for each sample. The ADC clock is
+ * F_CPU / 128 and each conversion takes 13 ADC clocks: about 9.6kHz on a
+ * 16MHz Uno.
+ *
+ * Defines ADC_SAMPLER where available. While sampling, analogRead() must not
+ * be used: call adc_sampler::stop() first.
+ */
+#ifndef ADC_SAMPLER_H
+#define ADC_SAMPLER_H
+#include <stdint.h>
+#include "audio-analyzer.h"
+
+#ifdef __AVR__
+#define ADC_SAMPLER
+
+/// Samples per second taken by the free-running ADC.
+#define ADC_SAMPLE_RATE (F_CPU / 128 / 13)
+
+namespace adc_sampler {
+
+/// Start filling a block of AUDIO_SAMPLES samples from the given analog pin in the background.
+void start(uint8_t pin);
+
+/// True once the block is full. The ADC stops by itself at that point.
+bool isFull(void);
+
+/// Stop sampling, if it has not stopped already, and hand the ADC back to analogRead().
+void stop(void);
+
+/// The samples taken since start(), as 8-bit readings.
+const volatile uint8_t* samples(void);
+
+}  // namespace adc_sampler
+#endif
+
+#endif
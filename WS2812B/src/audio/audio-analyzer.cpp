@@ -0,0 +1,163 @@
+/** @file */
+#include "audio-analyzer.h"
+
+/**
+ * 2cos(2πk/N) in Q14 fixed point for bins k = 1, 2, 4, 12 of a 32-sample
+ * block.
+ */
+static const int16_t GOERTZEL_COEFFICIENTS[AUDIO_BANDS] = {
+  32138,
+  30274,
+  23170,
+  -23170,
+};
+
+/// Band levels span this many 1/16 octaves of power below ceiling_: 8 doublings, or 24dB.
+#define LEVEL_RANGE 128
+
+/// Lowest value for ceiling_ so that background noise is not amplified to full brightness.
+#define MIN_CEILING 200
+
+/// How far a level may drop per millisecond, so that lights fade rather than flicker.
+#define LEVEL_FALLOFF_PER_MILLI 3
+
+/// Milliseconds for ceiling_ to relax by one step.
+#define CEILING_DECAY_MILLIS 8
+
+/// Bass energy below this, log2 in 4.4 fixed point, is background noise and never a beat.
+#define MIN_BASS 288
+
+/// How far the bass must rise above its running average to count as a beat: about 1.6 doublings.
+#define BEAT_THRESHOLD 26
+
+/// Minimum time between beats, in milliseconds.
+#define MIN_MILLIS_BETWEEN_BEATS 170
+
+/// Time constant of the running average of bass energy, in milliseconds.
+#define BASS_AVERAGE_MILLIS 120
+
+/// Most that one block may move the running average of bass energy, in 1/256ths.
+#define BASS_AVERAGE_MAX_WEIGHT 64
+
+/**
+ * log2 of value in 4.4 fixed point: the position of the highest set bit,
+ * followed by the next 4 bits as a fraction.
+ */
+static uint16_t log2Fixed(uint32_t value) {
+  if (value == 0) {
+    return 0;
+  }
+  uint8_t msb = 31;
+  while (!(value & 0x80000000UL)) {
+    value <<= 1;
+    msb--;
+  }
+  return ((uint16_t) msb << 4) | ((value >> 27) & 0x0F);
+}
+
+/// Inverse of log2Fixed, to within its precision.
+static uint32_t exp2Fixed(const uint16_t log) {
+  const uint8_t msb = log >> 4;
+  const uint32_t mantissa = 16 | (log & 0x0F);
+  return msb >= 4 ? mantissa << (msb - 4) : mantissa >> (4 - msb);
+}
+
+bool AudioAnalyzer::addSample(const uint8_t sample) {
+  if (sample_count_ < AUDIO_SAMPLES) {
+    samples_[sample_count_++] = sample;
+  }
+  return sample_count_ == AUDIO_SAMPLES;
+}
+
+/**
+ * Run one Goertzel filter over the buffered samples and return the power of
+ * its bin as log2 in 4.4 fixed point.
+ *
+ * Samples are centered on their mean, so the filter state stays below ±2^16
+ * for every band and the Q14 product always fits in 32 bits.
+ */
+uint16_t AudioAnalyzer::bandPower(const uint8_t band, const uint8_t mean) const {
+  const int32_t coefficient = GOERTZEL_COEFFICIENTS[band];
+  int32_t s1 = 0;
+  int32_t s2 = 0;
+  for (uint8_t i = 0; i < AUDIO_SAMPLES; i++) {
+    const int32_t s0 = (int16_t) samples_[i] - mean + ((coefficient * s1) >> 14) - s2;
+    s2 = s1;
+    s1 = s0;
+  }
+
+  // Drop 2 bits of precision so the squares stay well inside 32 bits.
+  s1 >>= 2;
+  s2 >>= 2;
+  const int32_t power = s1 * s1 + s2 * s2 - ((coefficient * s1) >> 14) * s2;
+  return power > 0 ? log2Fixed(power) : 0;
+}
+
+void AudioAnalyzer::analyze(uint16_t elapsed_millis) {
+  if (elapsed_millis > 1000) {
+    elapsed_millis = 1000;  // Everything has settled by then; keeps the sums below in range.
+  }
+
+  uint16_t sum = 0;
+  for (uint8_t i = 0; i < AUDIO_SAMPLES; i++) {
+    sum += samples_[i];
+  }
+  const uint8_t mean = sum / AUDIO_SAMPLES;
+
+  uint16_t powers[AUDIO_BANDS];
+  uint16_t loudest = MIN_CEILING;
+  for (uint8_t band = 0; band < AUDIO_BANDS; band++) {
+    powers[band] = bandPower(band, mean);
+    if (powers[band] > loudest) {
+      loudest = powers[band];
+    }
+  }
+
+  // Automatic gain: jump up to new peaks, then slowly relax.
+  ceiling_decay_millis_ += elapsed_millis;
+  const uint16_t decay = ceiling_decay_millis_ / CEILING_DECAY_MILLIS;
+  ceiling_decay_millis_ %= CEILING_DECAY_MILLIS;
+  ceiling_ = ceiling_ > decay ? ceiling_ - decay : 0;
+  if (loudest > ceiling_) {
+    ceiling_ = loudest;
+  }
+
+  const uint16_t falloff = elapsed_millis < 256 / LEVEL_FALLOFF_PER_MILLI
+      ? elapsed_millis * LEVEL_FALLOFF_PER_MILLI : 255;
+  for (uint8_t band = 0; band < AUDIO_BANDS; band++) {
+    uint8_t level = 0;
+    if (powers[band] + LEVEL_RANGE > ceiling_) {
+      const uint16_t scaled = (powers[band] + LEVEL_RANGE - ceiling_) * (256 / LEVEL_RANGE);
+      level = scaled > 255 ? 255 : scaled;
+    }
+    const uint8_t faded = levels_[band] > falloff ? levels_[band] - falloff : 0;
+    levels_[band] = level > faded ? level : faded;
+  }
+
+  // A beat is a sudden rise in the bass above its recent average. A 32-sample
+  // block is shorter than one cycle of a kick drum, so most of the kick
+  // shows up as the whole block moving away from the microphone's resting
+  // level rather than in the lowest Goertzel band.
+  const int16_t offset = (int16_t) ((sum << 1) - (resting_level_ >> 2));  // 8.6 fixed point
+  resting_level_ += offset >> 3;
+  const uint32_t bass_energy = (uint32_t) ((int32_t) offset * offset) + exp2Fixed(powers[0]);
+  const uint16_t bass = log2Fixed(bass_energy);
+  const uint16_t average = log2Fixed(bass_average_);
+  millis_since_beat_ = millis_since_beat_ + elapsed_millis < MIN_MILLIS_BETWEEN_BEATS
+      ? millis_since_beat_ + elapsed_millis : MIN_MILLIS_BETWEEN_BEATS;
+  beat_ = bass > MIN_BASS
+      && bass > average + BEAT_THRESHOLD
+      && millis_since_beat_ >= MIN_MILLIS_BETWEEN_BEATS;
+  if (beat_) {
+    millis_since_beat_ = 0;
+  }
+
+  // Move the average elapsed_millis / BASS_AVERAGE_MILLIS of the way toward
+  // the latest energy, in 1/256ths. At low frame rates it still spans a few
+  // blocks, as one block alone is too noisy to compare against.
+  const uint32_t share = ((uint32_t) elapsed_millis << 8) / BASS_AVERAGE_MILLIS;
+  const int16_t weight = share < BASS_AVERAGE_MAX_WEIGHT ? share : BASS_AVERAGE_MAX_WEIGHT;
+  bass_average_ += (((int32_t) bass_energy - (int32_t) bass_average_) >> 8) * weight;
+
+  sample_count_ = 0;
+}
@@ -0,0 +1,53 @@
+/** @file
+ * Fixed-point audio analysis for the microphone input.
+ *
+ * Blocks of AUDIO_SAMPLES 8-bit samples are passed through a bank of
+ * Goertzel filters, one per band, giving a level for each band and a beat
+ * flag based on the bass. Nothing here touches the hardware so the
+ * same code can be fed recorded audio on a desktop machine.
+ */
+#ifndef AUDIO_ANALYZER_H
+#define AUDIO_ANALYZER_H
+#include <stdint.h>
+
+/// Samples per analysis block. Each band is 1/32 of the sample rate wide: 250Hz at 8kHz.
+#define AUDIO_SAMPLES 32
+
+/// Number of frequency bands, at 1, 2, 4 and 12 32nds of the sample rate: 250Hz, 500Hz, 1kHz and 3kHz at 8kHz.
+#define AUDIO_BANDS 4
+
+class AudioAnalyzer {
+ public:
+  /// Add the next sample to the buffer. Returns true when the buffer is full.
+  bool addSample(uint8_t sample);
+
+  /**
+   * Update levels and beat from the buffered samples, then empty the buffer.
+   *
+   * @param elapsed_millis Time since the previous block, so that fading and
+   *                       beat timing do not depend on the frame rate.
+   */
+  void analyze(uint16_t elapsed_millis);
+
+  /// Loudness of the given band from 0 to 255, relative to recent peaks.
+  uint8_t level(uint8_t band) const { return levels_[band]; }
+
+  /// True if the most recent block started a beat.
+  bool isBeat(void) const { return beat_; }
+
+ private:
+  uint8_t samples_[AUDIO_SAMPLES];
+  uint8_t sample_count_ = 0;
+
+  uint8_t levels_[AUDIO_BANDS] = {0};
+  uint16_t ceiling_ = 0;        ///< Loudest recent band power, log2 in 4.4 fixed point
+  uint16_t resting_level_ = 128 << 8;  ///< Microphone output with no sound, in 8.8 fixed point
+  uint32_t bass_average_ = 0;          ///< Running average of bass energy
+  uint16_t ceiling_decay_millis_ = 0;  ///< Time toward the next step down of ceiling_
+  uint8_t millis_since_beat_ = 0;      ///< Up to MIN_MILLIS_BETWEEN_BEATS
+  bool beat_ = false;
+
+  uint16_t bandPower(uint8_t band, uint8_t mean) const;
+};
+
+#endif
@@ -0,0 +1,99 @@
+/** @file */
+#include "input.h"
+#include "../../hardware-config.h"
+#include "../audio/adc-sampler.h"
+#include "../audio/audio-analyzer.h"
+
+/**
+ * Base class for handling input from an analog microphone.
+ *
+ * Call startSampling() when the CPU would otherwise be idle, e.g. just before
+ * waiting for the next frame, then update() on the next frame to analyze the
+ * block and pass the result to onAudioAnalyzed.
+ *
+ * On AVR the block fills in the background from the ADC interrupt, in about
+ * 3.3ms. Elsewhere startSampling() reads the block at AUDIO_SAMPLE_RATE
+ * there and then, blocking for AUDIO_SAMPLES / AUDIO_SAMPLE_RATE seconds.
+ */
+class AbstractMicrophoneHandler: AbstractInputHandler
+{
+public:
+  static const unsigned long SAMPLE_INTERVAL_MICROS = 1000000UL / AUDIO_SAMPLE_RATE;
+
+  AbstractMicrophoneHandler(uint8_t pin): AbstractInputHandler(pin)
+  {
+
+  }
+
+  virtual void onAudioAnalyzed(const AudioAnalyzer& analyzer) = 0;
+
+  void setup(void) {
+
+  }
+
+  void startSampling(void)
+  {
+    #ifdef ADC_SAMPLER
+    adc_sampler::start(pin_);
+    #else
+    const unsigned long started = getTimestampMicros();
+    unsigned long next_sample = started;
+    bool full = false;
+    while (!full) {
+      while ((long) (getTimestampMicros() - next_sample) < 0) {
+        // Wait for the next sample time.
+      }
+      next_sample += SAMPLE_INTERVAL_MICROS;
+      full = analyzer_.addSample(readAnalog() >> 2);  // 10-bit reading to 8-bit sample
+    }
+    cpu_micros_ = getTimestampMicros() - started;
+    #endif
+    sampling_ = true;
+  }
+
+  /**
+   * Analyze the block started by the last startSampling(). Must be called
+   * before any other input uses analogRead().
+   */
+  void update(void)
+  {
+    if (!sampling_) {
+      return;
+    }
+    const unsigned long started = getTimestampMicros();
+
+    #ifdef ADC_SAMPLER
+    // Only waits if the frame delay was shorter than the block.
+    while (!adc_sampler::isFull()) {
+    }
+    adc_sampler::stop();
+    const volatile uint8_t* samples = adc_sampler::samples();
+    for (uint8_t i = 0; i < AUDIO_SAMPLES; i++) {
+      analyzer_.addSample(samples[i]);
+    }
+    cpu_micros_ = 0;
+    #endif
+
+    const unsigned long elapsed_millis = (started - analyzed_micros_) / 1000;
+    analyzer_.analyze(elapsed_millis < 1000 ? elapsed_millis : 1000);
+    analyzed_micros_ = started;
+    onAudioAnalyzed(analyzer_);
+    sampling_ = false;
+    cpu_micros_ += getTimestampMicros() - started;
+  }
+
+  /**
+   * Time taken from the main loop by the last block, in microseconds:
+   * blocking reads where there is no background sampling, waiting for the
+   * block to fill, and analysis. Does not include the ADC interrupt.
+   */
+  unsigned long cpuMicros(void) const {
+    return cpu_micros_;
+  }
+
+protected:
+  AudioAnalyzer analyzer_;
+  bool sampling_ = false;
+  unsigned long cpu_micros_ = 0;
+  unsigned long analyzed_micros_ = 0;  ///< When the last block was analyzed
+};
@@ -10,6 +10,7 @@ void pinMode(uint8_t pin, uint8_t mode) {}
 void digitalWrite(uint8_t pin, uint8_t mode) {}
 int digitalRead(uint8_t pin) { return 0; }
 unsigned long millis() { return 0; }
+unsigned long micros() { return 0; }
 int analogRead(uint8_t pin) { return 0; }
 #endif
 
@@ -47,6 +48,10 @@ class AbstractInputHandler
         return millis();
     };
 
+    virtual unsigned long getTimestampMicros() {
+        return micros();
+    };
+
     virtual int readAnalog() {
         return analogRead(pin_);
     };
@@ -0,0 +1,130 @@
+/** @file
+ * Maps (x, y) positions on a 2D LED panel to indices in the LED array.
+ *
+ * The mapping for every pixel is worked out by the compiler into a table in
+ * flash (PROGMEM), so animations can walk a row with a plain table lookup
+ * and the table costs no RAM. layout::Panel is the panel configured with
+ * MATRIX_WIDTH and MATRIX_HEIGHT in hardware-config.h.
+ */
+#define FASTLED_INTERNAL  // Disable pragma version message on compilation
+#ifndef LAYOUT_H
+#define LAYOUT_H
+#include <FastLED.h>
+#include <stdint.h>
+#include "../../hardware-config.h"
+
+namespace layout {
+
+/// Smallest unsigned type that can index every LED of a panel.
+template <bool FITS_IN_BYTE>
+struct IndexType {
+  typedef uint8_t type;
+};
+
+template <>
+struct IndexType<false> {
+  typedef uint16_t type;
+};
+
+/*
+ * The integers 0 to N - 1 as a template parameter pack, for expanding into
+ * a table initializer. Built by halves so that panels of 1024 LEDs stay
+ * well inside the compiler's template depth limit.
+ */
+template <uint16_t... I>
+struct Sequence {};
+
+template <typename First, typename Second>
+struct Concatenate;
+
+template <uint16_t... First, uint16_t... Second>
+struct Concatenate<Sequence<First...>, Sequence<Second...>> {
+  typedef Sequence<First..., (sizeof...(First) + Second)...> type;
+};
+
+template <uint16_t N>
+struct MakeSequence {
+  typedef typename Concatenate<
+      typename MakeSequence<N / 2>::type,
+      typename MakeSequence<N - N / 2>::type>::type type;
+};
+
+template <>
+struct MakeSequence<0> {
+  typedef Sequence<> type;
+};
+
+template <>
+struct MakeSequence<1> {
+  typedef Sequence<0> type;
+};
+
+/// The index of every pixel of Layout, row by row, stored in flash.
+template <typename Layout, typename Indices>
+struct Table;
+
+template <typename Layout, uint16_t... I>
+struct Table<Layout, Sequence<I...>> {
+  static const typename Layout::LedIndex VALUES[sizeof...(I)];
+};
+
+template <typename Layout, uint16_t... I>
+const typename Layout::LedIndex Table<Layout, Sequence<I...>>::VALUES[sizeof...(I)] PROGMEM = {
+  Layout::index(I)...
+};
+
+/**
+ * A panel of WIDTH x HEIGHT pixels as seen by the viewer.
+ *
+ * @tparam SERPENTINE_ If true, alternate rows are wired in opposite directions.
+ * @tparam ROTATION_   Number of clockwise quarter turns between the panel wiring and the viewer.
+ */
+template <uint8_t WIDTH_, uint8_t HEIGHT_, bool SERPENTINE_ = true, uint8_t ROTATION_ = 0>
+struct Matrix {
+  static const uint8_t WIDTH = WIDTH_;
+  static const uint8_t HEIGHT = HEIGHT_;
+  static const uint16_t COUNT = (uint16_t) WIDTH_ * HEIGHT_;
+
+  typedef typename IndexType<COUNT <= 256>::type LedIndex;
+
+  /// LED array index of the nth pixel, counting row by row as seen by the viewer.
+  static constexpr LedIndex index(uint16_t n) {
+    return at(n % WIDTH, n / WIDTH);
+  }
+
+  /// LED array indices for each pixel in row y, from left to right. Read them with read().
+  static const LedIndex* row(uint8_t y) {
+    return Table<Matrix, typename MakeSequence<COUNT>::type>::VALUES + (uint16_t) y * WIDTH;
+  }
+
+  /// The LED array index stored at entry, which points into a row().
+  static LedIndex read(const LedIndex* entry) {
+    return sizeof(LedIndex) == 1 ? pgm_read_byte(entry) : pgm_read_word(entry);
+  }
+
+  static LedIndex XY(uint8_t x, uint8_t y) {
+    return read(row(y) + x);
+  }
+
+ private:
+  static constexpr LedIndex at(uint8_t x, uint8_t y) {
+    return (ROTATION_ & 3) == 0 ? physicalIndex(x, y, WIDTH)
+         : (ROTATION_ & 3) == 1 ? physicalIndex(y, WIDTH - 1 - x, HEIGHT)
+         : (ROTATION_ & 3) == 2 ? physicalIndex(WIDTH - 1 - x, HEIGHT - 1 - y, WIDTH)
+         : physicalIndex(HEIGHT - 1 - y, x, HEIGHT);
+  }
+
+  /// Index of the given physical position on a panel whose rows are panel_width pixels long.
+  static constexpr LedIndex physicalIndex(uint8_t px, uint8_t py, uint8_t panel_width) {
+    return (uint16_t) py * panel_width + (SERPENTINE_ && (py & 1) ? panel_width - 1 - px : px);
+  }
+};
+
+#ifdef MATRIX_WIDTH
+/// The panel described by hardware-config.h.
+typedef Matrix<MATRIX_WIDTH, MATRIX_HEIGHT, MATRIX_SERPENTINE, MATRIX_ROTATION> Panel;
+#endif
+
+}  // namespace layout
+
+#endif
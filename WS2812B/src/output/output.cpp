@@ -0,0 +1,95 @@
+/** @file */
+#include "output.h"
+#include <string.h>
+
+#ifdef PIPELINED_OUTPUT
+#if defined(ESP32)
+#define OUTPUT_ESP32_TASK
+#elif defined(__linux__) || defined(__APPLE__) || defined(_WIN32)
+#define OUTPUT_HOST_THREAD
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#else
+#error "PIPELINED_OUTPUT needs a second core to transmit from: ESP32, or a desktop build for the host tests"
+#endif
+
+FASTLED_USING_NAMESPACE
+namespace output {
+
+CRGB buffers_[2][NUM_LEDS];
+
+#if defined(OUTPUT_ESP32_TASK)
+TaskHandle_t transmit_task_ = nullptr;
+TaskHandle_t render_task_ = nullptr;
+bool transmitting_ = false;
+
+void transmit(void* parameters) {
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    FastLED.show();
+    xTaskNotifyGive(render_task_);
+  }
+}
+
+void setup(void) {
+  render_task_ = xTaskGetCurrentTaskHandle();
+  // Arduino loop() runs on core 1, so transmit from core 0.
+  xTaskCreatePinnedToCore(transmit, "output", 2048, nullptr, 2, &transmit_task_, 0);
+}
+
+void startTransmitting(CRGB* leds) {
+  if (transmitting_) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+  }
+  FastLED[0].setLeds(leds, NUM_LEDS);
+  transmitting_ = true;
+  xTaskNotifyGive(transmit_task_);
+}
+
+#elif defined(OUTPUT_HOST_THREAD)
+std::mutex mutex_;
+std::condition_variable changed_;
+bool transmitting_ = false;
+
+void transmit(void) {
+  for (;;) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    changed_.wait(lock, [] { return transmitting_; });
+    lock.unlock();
+
+    FastLED.show();
+
+    lock.lock();
+    transmitting_ = false;
+    changed_.notify_all();
+  }
+}
+
+void setup(void) {
+  std::thread(transmit).detach();
+}
+
+void startTransmitting(CRGB* leds) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  changed_.wait(lock, [] { return !transmitting_; });
+  FastLED[0].setLeds(leds, NUM_LEDS);
+  transmitting_ = true;
+  changed_.notify_all();
+}
+#endif
+
+CRGB* firstBuffer(void) {
+  return buffers_[0];
+}
+
+CRGB* show(CRGB* leds) {
+  startTransmitting(leds);
+  CRGB* next = leds == buffers_[0] ? buffers_[1] : buffers_[0];
+  memcpy(next, leds, sizeof(buffers_[0]));
+  return next;
+}
+
+}  // namespace output
+FASTLED_NAMESPACE_END
+#endif
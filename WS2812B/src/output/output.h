@@ -0,0 +1,45 @@
+/** @file
+ * Pipelined LED output: transmit one frame while the next one renders.
+ *
+ * Enabled by defining PIPELINED_OUTPUT in hardware-config.h. Two frame
+ * buffers are used in turn. output::show() hands the buffer that was just
+ * rendered to a background transmitter and returns the other one, holding
+ * a copy of the frame being transmitted so that animations which build on
+ * the previous frame (FADE, +=) carry on as before.
+ *
+ * Transmitters:
+ * - ESP32: FastLED.show() runs in a task on the other core, so the RMT
+ *   output and rendering overlap.
+ * - Desktop hosts: FastLED.show() runs in a thread, for the host tests and
+ *   benchmarks in tests/.
+ * Other boards are not supported: with one core, nothing would overlap.
+ */
+#define FASTLED_INTERNAL  // Disable pragma version message on compilation
+#ifndef OUTPUT_H
+#define OUTPUT_H
+#include <FastLED.h>
+#include "../../hardware-config.h"
+
+FASTLED_USING_NAMESPACE
+
+#ifdef PIPELINED_OUTPUT
+namespace output {
+
+/// Start the transmitter. Call once, after FastLED.addLeds().
+void setup(void);
+
+/// The buffer to render the first frame into, and to pass to FastLED.addLeds().
+CRGB* firstBuffer(void);
+
+/**
+ * Wait for the previous frame to finish transmitting, start transmitting
+ * leds, then return the buffer to render the next frame into.
+ */
+CRGB* show(CRGB* leds);
+
+}  // namespace output
+#endif
+
+FASTLED_NAMESPACE_END
+
+#endif
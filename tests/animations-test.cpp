@@ -0,0 +1,106 @@
+/** @file
+ * Runs every animation for a few thousand frames at the slowest, normal and
+ * fastest animation speeds. Built with the address and undefined behavior
+ * sanitizers for a 150-LED strip and for 16x16 and 32x32 panels, so that
+ * any access outside the LED array or an animation's own state fails the
+ * test. Also checks that every animation still moves at the slowest speed.
+ */
+#include <FastLED.h>
+#include <stdio.h>
+#include <string.h>
+#include "check.h"
+#include "src/animation/animations.h"
+
+CHECK_MAIN_STATE
+
+using animations::MainStrip;
+
+#define FRAMES 3000
+#define FRAME_MILLIS 8
+
+CRGB leds_[NUM_LEDS];
+
+struct Animation {
+  const char* name;
+  void (*render)(CRGB leds[]);
+};
+
+static void transitionFadeToGold(CRGB leds[]) {
+  animations::transitionFadeToSolid<MainStrip>(leds, CRGB::Gold);
+}
+
+static void transitionLinearToGold(CRGB leds[]) {
+  animations::transitionLinearToSolid<MainStrip>(leds, CRGB::Gold);
+}
+
+/// Every animation except polychromeStorm and polychromeSplash, which are not written yet.
+static const Animation ANIMATIONS[] = {
+  { "polychromeBpm", animations::polychromeBpm<MainStrip> },
+  { "polychromeConfetti", animations::polychromeConfetti<MainStrip> },
+  { "polychromeJuggle", animations::polychromeJuggle<MainStrip> },
+  { "polychromeRainbow", animations::polychromeRainbow<MainStrip> },
+  { "polychromeRainbowWithGlitter", animations::polychromeRainbowWithGlitter<MainStrip> },
+  { "polychromeSinelon", animations::polychromeSinelon<MainStrip> },
+  { "monochromeRainbow", animations::monochromeRainbow<MainStrip> },
+  { "monochromeJuggle", animations::monochromeJuggle<MainStrip> },
+  { "monochromeGlitter", animations::monochromeGlitter<MainStrip> },
+  { "monochromeSinelon", animations::monochromeSinelon<MainStrip> },
+  { "monochromePulse", animations::monochromePulse<MainStrip> },
+  { "paletteFlow", animations::paletteFlow<MainStrip> },
+  { "paletteFlowWithGlitter", animations::paletteFlowWithGlitter<MainStrip> },
+  { "paletteGlitter", animations::paletteGlitter<MainStrip> },
+  { "twinkleFairyLights", animations::twinkleFairyLights<MainStrip> },
+  { "twinkleMonochrome", animations::twinkleMonochrome<MainStrip> },
+  { "twinklePalette", animations::twinklePalette<MainStrip> },
+  { "noiseAurora", animations::noiseAurora<MainStrip> },
+  { "noiseClouds", animations::noiseClouds<MainStrip> },
+  { "noiseFire", animations::noiseFire<MainStrip> },
+#ifdef MATRIX_WIDTH
+  { "matrixFlow", animations::matrixFlow<MainStrip> },
+  { "matrixJuggle", animations::matrixJuggle<MainStrip> },
+  { "matrixSinelon", animations::matrixSinelon<MainStrip> },
+#endif
+  { "transitionFadeToSolid", transitionFadeToGold },
+  { "transitionLinearToSolid", transitionLinearToGold },
+};
+
+/// Run animation for FRAMES frames and return how many of them changed any LED.
+static int run(const Animation& animation, float speed) {
+  animations::animation_speed_multiplier_ = speed;
+  animations::palette_ = PartyColors_p;
+  animations::static_color_hsv_ = CHSV(32, 255, 255);
+  animations::transition_progress_ = 0;
+
+  static CRGB previous[NUM_LEDS];
+  int changed = 0;
+  for (int frame = 0; frame < FRAMES; frame++) {
+    host::advanceMillis(FRAME_MILLIS);
+    if (frame % 3 == 0) {
+      animations::hue_++;
+    }
+    memcpy(previous, leds_, sizeof(leds_));
+    animation.render(leds_);
+    if (memcmp(previous, leds_, sizeof(leds_)) != 0) {
+      changed++;
+    }
+  }
+  return changed;
+}
+
+int main(void) {
+  printf("%u LEDs\n", NUM_LEDS);
+  for (const Animation& animation : ANIMATIONS) {
+    const int slow = run(animation, 0.1f);
+    run(animation, 1.0f);
+    run(animation, 2.0f);
+
+    // The transitions settle on the target color and stop.
+    if (strncmp(animation.name, "transition", 10) != 0) {
+      CHECK(slow >= FRAMES / 10, "%s: only %d of %d frames changed at the slowest speed",
+            animation.name, slow, FRAMES);
+    }
+  }
+
+  printf("%d failures\n", check::failures_);
+  return check::failures_;
+}
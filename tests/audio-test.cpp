@@ -0,0 +1,451 @@
+/** @file
+ * Runs recordings through AudioAnalyzer the way the sketch does: one block
+ * of AUDIO_SAMPLES 8-bit samples at the start of each frame, with the rest
+ * of the frame unheard.
+ *
+ * With no arguments, generates test recordings (drum patterns over music
+ * and noise, steady sounds with no beats, and pure tones), writes each to a
+ * WAV file, reads it back and checks the band levels and the beat
+ * detection against the known beat times.
+ *
+ * With arguments, analyzes a recording of your own:
+ *
+ *     audio-test recording.wav [beats.txt]
+ *
+ * where beats.txt holds the time of each beat in seconds, one per line.
+ * Mono or stereo 8- or 16-bit PCM WAV files are accepted.
+ */
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "bench.h"
+#include "check.h"
+#include "src/audio/audio-analyzer.h"
+
+CHECK_MAIN_STATE
+
+/// Sample rate of the free-running ADC on a 16MHz AVR: see adc-sampler.h.
+#define DEVICE_SAMPLE_RATE (16000000.0 / 128 / 13)
+
+/// Frame period on an Uno at 120fps: an 8ms frame delay, 4.5ms to send 150 LEDs, and rendering.
+#define DEVICE_FRAME_SECONDS 0.013
+
+/// A detected beat this close to a real one counts as a hit.
+#define BEAT_TOLERANCE_SECONDS 0.07
+
+struct Recording {
+  std::vector<float> samples;  ///< Mono, from -1 to 1
+  double sample_rate;
+
+  double duration(void) const { return samples.size() / sample_rate; }
+
+  /// Linearly interpolated value at the given time.
+  float at(double seconds) const {
+    const double position = seconds * sample_rate;
+    const size_t i = (size_t) position;
+    if (i + 1 >= samples.size()) {
+      return 0;
+    }
+    const float fraction = position - i;
+    return samples[i] * (1 - fraction) + samples[i + 1] * fraction;
+  }
+};
+
+// WAV files.
+
+static void writeWav(const char* path, const Recording& recording) {
+  FILE* file = fopen(path, "wb");
+  if (!file) {
+    perror(path);
+    exit(1);
+  }
+  const uint32_t rate = (uint32_t) recording.sample_rate;
+  const uint32_t data_bytes = recording.samples.size() * 2;
+  const uint32_t riff_bytes = 36 + data_bytes;
+  const uint32_t format_bytes = 16;
+  const uint16_t format = 1;  // PCM
+  const uint16_t channels = 1;
+  const uint32_t byte_rate = rate * 2;
+  const uint16_t block_align = 2;
+  const uint16_t bits = 16;
+
+  fwrite("RIFF", 1, 4, file);
+  fwrite(&riff_bytes, 4, 1, file);
+  fwrite("WAVEfmt ", 1, 8, file);
+  fwrite(&format_bytes, 4, 1, file);
+  fwrite(&format, 2, 1, file);
+  fwrite(&channels, 2, 1, file);
+  fwrite(&rate, 4, 1, file);
+  fwrite(&byte_rate, 4, 1, file);
+  fwrite(&block_align, 2, 1, file);
+  fwrite(&bits, 2, 1, file);
+  fwrite("data", 1, 4, file);
+  fwrite(&data_bytes, 4, 1, file);
+  for (float sample : recording.samples) {
+    const float clamped = sample > 1 ? 1 : sample < -1 ? -1 : sample;
+    const int16_t value = (int16_t) lrintf(clamped * 32767);
+    fwrite(&value, 2, 1, file);
+  }
+  fclose(file);
+}
+
+static bool readWav(const char* path, Recording& recording) {
+  FILE* file = fopen(path, "rb");
+  if (!file) {
+    perror(path);
+    return false;
+  }
+  char id[4];
+  uint32_t size;
+  if (fread(id, 1, 4, file) != 4 || memcmp(id, "RIFF", 4) != 0
+      || fread(&size, 4, 1, file) != 1
+      || fread(id, 1, 4, file) != 4 || memcmp(id, "WAVE", 4) != 0) {
+    fprintf(stderr, "%s: not a WAV file\n", path);
+    fclose(file);
+    return false;
+  }
+
+  uint16_t format = 0;
+  uint16_t channels = 0;
+  uint32_t rate = 0;
+  uint16_t bits = 0;
+  while (fread(id, 1, 4, file) == 4 && fread(&size, 4, 1, file) == 1) {
+    if (memcmp(id, "fmt ", 4) == 0) {
+      std::vector<uint8_t> chunk(size);
+      if (size < 16 || fread(chunk.data(), 1, size, file) != size) {
+        break;
+      }
+      memcpy(&format, &chunk[0], 2);
+      memcpy(&channels, &chunk[2], 2);
+      memcpy(&rate, &chunk[4], 4);
+      memcpy(&bits, &chunk[14], 2);
+    }
+    else if (memcmp(id, "data", 4) == 0) {
+      if (format != 1 || (bits != 8 && bits != 16) || channels < 1) {
+        fprintf(stderr, "%s: only 8- or 16-bit PCM is supported\n", path);
+        break;
+      }
+      const uint32_t frame_bytes = channels * bits / 8;
+      std::vector<uint8_t> data(size);
+      const size_t read = fread(data.data(), 1, size, file);
+      recording.sample_rate = rate;
+      recording.samples.clear();
+      for (size_t offset = 0; offset + frame_bytes <= read; offset += frame_bytes) {
+        float sum = 0;
+        for (uint16_t channel = 0; channel < channels; channel++) {
+          if (bits == 8) {
+            sum += (data[offset + channel] - 128) / 128.f;
+          }
+          else {
+            int16_t value;
+            memcpy(&value, &data[offset + channel * 2], 2);
+            sum += value / 32768.f;
+          }
+        }
+        recording.samples.push_back(sum / channels);
+      }
+      fclose(file);
+      return true;
+    }
+    else {
+      fseek(file, size + (size & 1), SEEK_CUR);
+    }
+  }
+  fprintf(stderr, "%s: no audio data\n", path);
+  fclose(file);
+  return false;
+}
+
+// Running the analyzer.
+
+struct Result {
+  std::vector<double> beats;                    ///< Time of each detected beat
+  std::vector<uint8_t> levels[AUDIO_BANDS];     ///< Level of each band, per frame
+  double micros_per_block = 0;                  ///< Host time to add and analyze one block
+};
+
+/// The microphone preamp centers its output on half the ADC range.
+static uint8_t toAdcSample(float value) {
+  const float scaled = 128 + value * 127;
+  return scaled < 0 ? 0 : scaled > 255 ? 255 : (uint8_t) lrintf(scaled);
+}
+
+static Result analyze(const Recording& recording, double frame_seconds = DEVICE_FRAME_SECONDS) {
+  Result result;
+  AudioAnalyzer analyzer;
+  unsigned long analyzed_millis = 0;
+  for (double frame = 0; frame + AUDIO_SAMPLES / DEVICE_SAMPLE_RATE < recording.duration(); frame += frame_seconds) {
+    for (uint8_t i = 0; i < AUDIO_SAMPLES; i++) {
+      analyzer.addSample(toAdcSample(recording.at(frame + i / DEVICE_SAMPLE_RATE)));
+    }
+    // Whole milliseconds between blocks, as the sketch measures them.
+    const unsigned long millis = (unsigned long) (frame * 1000);
+    analyzer.analyze(millis - analyzed_millis);
+    analyzed_millis = millis;
+    if (analyzer.isBeat()) {
+      result.beats.push_back(frame);
+    }
+    for (uint8_t band = 0; band < AUDIO_BANDS; band++) {
+      result.levels[band].push_back(analyzer.level(band));
+    }
+  }
+
+  uint8_t block[AUDIO_SAMPLES];
+  for (uint8_t i = 0; i < AUDIO_SAMPLES; i++) {
+    block[i] = toAdcSample(recording.at(1 + i / DEVICE_SAMPLE_RATE));
+  }
+  result.micros_per_block = bench::nanosPerCall([&] {
+    for (uint8_t i = 0; i < AUDIO_SAMPLES; i++) {
+      analyzer.addSample(block[i]);
+    }
+    analyzer.analyze(frame_seconds * 1000);
+  }) / 1000;
+  return result;
+}
+
+struct Accuracy {
+  int hits = 0;
+  int misses = 0;
+  int false_beats = 0;
+
+  double precision(void) const { return hits + false_beats ? (double) hits / (hits + false_beats) : 1; }
+  double recall(void) const { return hits + misses ? (double) hits / (hits + misses) : 1; }
+};
+
+/**
+ * Match each real beat with at most one detected beat within
+ * BEAT_TOLERANCE_SECONDS. A beat can only be heard in the first block after
+ * it, so detections may also be up to one frame later than that.
+ */
+static Accuracy score(const std::vector<double>& detected, const std::vector<double>& expected,
+                      double frame_seconds = DEVICE_FRAME_SECONDS) {
+  Accuracy accuracy;
+  std::vector<bool> used(detected.size(), false);
+  for (double beat : expected) {
+    bool hit = false;
+    for (size_t i = 0; i < detected.size(); i++) {
+      const double late = detected[i] - beat;
+      if (!used[i] && late >= -BEAT_TOLERANCE_SECONDS && late <= BEAT_TOLERANCE_SECONDS + frame_seconds) {
+        used[i] = true;
+        hit = true;
+        break;
+      }
+    }
+    if (hit) {
+      accuracy.hits++;
+    } else {
+      accuracy.misses++;
+    }
+  }
+  for (bool u : used) {
+    if (!u) {
+      accuracy.false_beats++;
+    }
+  }
+  return accuracy;
+}
+
+// Test recordings.
+
+#define TEST_SAMPLE_RATE 44100
+
+static Recording silence(double seconds) {
+  Recording recording;
+  recording.sample_rate = TEST_SAMPLE_RATE;
+  recording.samples.assign((size_t) (seconds * TEST_SAMPLE_RATE), 0.f);
+  return recording;
+}
+
+static void addTone(Recording& recording, double frequency, float amplitude) {
+  for (size_t i = 0; i < recording.samples.size(); i++) {
+    recording.samples[i] += amplitude * sin(2 * M_PI * frequency * i / recording.sample_rate);
+  }
+}
+
+static void addNoise(Recording& recording, float amplitude, unsigned seed) {
+  srand(seed);
+  for (float& sample : recording.samples) {
+    sample += amplitude * (2.f * rand() / RAND_MAX - 1);
+  }
+}
+
+/// A kick drum: a sine sweeping down from 150Hz to 50Hz, dying away over about 150ms.
+static void addKick(Recording& recording, double start, float amplitude) {
+  double phase = 0;
+  const size_t first = (size_t) (start * recording.sample_rate);
+  const size_t length = (size_t) (0.25 * recording.sample_rate);
+  for (size_t i = 0; i < length && first + i < recording.samples.size(); i++) {
+    const double t = i / recording.sample_rate;
+    phase += 2 * M_PI * (50 + 100 * exp(-t / 0.03)) / recording.sample_rate;
+    recording.samples[first + i] += amplitude * exp(-t / 0.05) * sin(phase);
+  }
+}
+
+/// A closed hi-hat: a 20ms burst of noise.
+static void addHiHat(Recording& recording, double start, float amplitude) {
+  const size_t first = (size_t) (start * recording.sample_rate);
+  const size_t length = (size_t) (0.06 * recording.sample_rate);
+  for (size_t i = 0; i < length && first + i < recording.samples.size(); i++) {
+    const double t = i / recording.sample_rate;
+    recording.samples[first + i] += amplitude * exp(-t / 0.02) * (2.f * rand() / RAND_MAX - 1);
+  }
+}
+
+/**
+ * A kick on every beat and a hi-hat between them, over chords and noise.
+ * Returns the time of each kick in beats.
+ */
+static Recording drumPattern(double bpm, float kick, float music, float noise, std::vector<double>& beats) {
+  Recording recording = silence(12);
+  addTone(recording, 220, music);
+  addTone(recording, 277, music);
+  addTone(recording, 330, music);
+  addTone(recording, 880, music / 2);
+  addNoise(recording, noise, (unsigned) bpm);
+  const double interval = 60 / bpm;
+  for (double t = 0.5; t < recording.duration() - 0.5; t += interval) {
+    addKick(recording, t, kick);
+    addHiHat(recording, t + interval / 2, kick / 3);
+    beats.push_back(t);
+  }
+  return recording;
+}
+
+/// Write the recording out and read it back, to run it through the same path as a real file.
+static Recording throughWav(const Recording& recording, const char* name) {
+  const std::string path = std::string(name) + ".wav";
+  writeWav(path.c_str(), recording);
+  Recording read;
+  CHECK(readWav(path.c_str(), read), "%s", path.c_str());
+  remove(path.c_str());
+  return read;
+}
+
+static void testBeats(void) {
+  struct Case {
+    const char* name;
+    double bpm;
+    float kick;
+    float music;
+    float noise;
+  };
+  const Case cases[] = {
+    { "kick-only-120", 120, 0.7f, 0, 0 },
+    { "music-90", 90, 0.6f, 0.08f, 0.02f },
+    { "music-120", 120, 0.6f, 0.08f, 0.02f },
+    { "music-140", 140, 0.6f, 0.08f, 0.02f },
+    { "music-174", 174, 0.6f, 0.08f, 0.02f },
+    { "quiet-120", 120, 0.25f, 0.03f, 0.01f },
+    { "noisy-120", 120, 0.6f, 0.08f, 0.1f },
+  };
+
+  // Frame periods of a short strip at 120fps, of 150 LEDs on an Uno, and
+  // of the slower speeds set with the potentiometer.
+  const double frame_periods[] = { 1.0 / 120, DEVICE_FRAME_SECONDS, 1.0 / 60, 1.0 / 24, 1.0 / 12 };
+
+  printf("%-16s %6s %5s %5s %7s %10s %7s\n", "recording", "frame", "beats", "hits", "false", "precision", "recall");
+  for (const Case& c : cases) {
+    std::vector<double> expected;
+    const Recording recording = throughWav(drumPattern(c.bpm, c.kick, c.music, c.noise, expected), c.name);
+    for (double frame_seconds : frame_periods) {
+      const Accuracy accuracy = score(analyze(recording, frame_seconds).beats, expected, frame_seconds);
+      printf("%-16s %4.1fms %5zu %5d %7d %10.2f %7.2f\n", c.name, frame_seconds * 1000, expected.size(),
+             accuracy.hits, accuracy.false_beats, accuracy.precision(), accuracy.recall());
+      CHECK(accuracy.precision() >= 0.9, "%s: precision %.2f", c.name, accuracy.precision());
+      // At 12fps one 3.3ms block every 83ms often lands after a kick has
+      // died away, so fast tempos lose beats however they are detected.
+      const double min_recall = frame_seconds < 0.05 ? 0.9 : 0.5;
+      CHECK(accuracy.recall() >= min_recall, "%s: recall %.2f", c.name, accuracy.recall());
+    }
+  }
+
+  // Steady sounds must not produce beats.
+  Recording quiet = silence(10);
+  Recording chords = silence(10);
+  addTone(chords, 220, 0.2f);
+  addTone(chords, 330, 0.2f);
+  Recording hiss = silence(10);
+  addNoise(hiss, 0.2f, 1);
+  const Recording* steady[] = { &quiet, &chords, &hiss };
+  const char* steady_names[] = { "silence", "chords", "hiss" };
+  for (int i = 0; i < 3; i++) {
+    const Recording recording = throughWav(*steady[i], steady_names[i]);
+    for (double frame_seconds : frame_periods) {
+      const Result result = analyze(recording, frame_seconds);
+      printf("%-16s %4.1fms %5d %5d %7zu\n", steady_names[i], frame_seconds * 1000, 0, 0, result.beats.size());
+      CHECK(result.beats.empty(), "%s: %zu false beats", steady_names[i], result.beats.size());
+    }
+  }
+}
+
+/// A tone at the center of each band should light that band above the others.
+static void testBands(void) {
+  const uint8_t bins[AUDIO_BANDS] = { 1, 2, 4, 12 };
+  for (uint8_t band = 0; band < AUDIO_BANDS; band++) {
+    Recording recording = silence(2);
+    addTone(recording, bins[band] * DEVICE_SAMPLE_RATE / AUDIO_SAMPLES, 0.5f);
+    const Result result = analyze(recording);
+    const size_t last = result.levels[band].size() - 1;
+    printf("tone in band %u: levels", band);
+    for (uint8_t other = 0; other < AUDIO_BANDS; other++) {
+      printf(" %3u", result.levels[other][last]);
+    }
+    printf("\n");
+    CHECK(result.levels[band][last] >= 200, "band %u: level %u", band, result.levels[band][last]);
+    for (uint8_t other = 0; other < AUDIO_BANDS; other++) {
+      if (other != band) {
+        CHECK(result.levels[other][last] + 64 <= result.levels[band][last],
+              "tone in band %u: band %u level %u", band, other, result.levels[other][last]);
+      }
+    }
+  }
+}
+
+static std::vector<double> readBeats(const char* path) {
+  std::vector<double> beats;
+  FILE* file = fopen(path, "r");
+  if (!file) {
+    perror(path);
+    exit(1);
+  }
+  double beat;
+  while (fscanf(file, "%lf", &beat) == 1) {
+    beats.push_back(beat);
+  }
+  fclose(file);
+  return beats;
+}
+
+int main(int argc, char** argv) {
+  if (argc > 1) {
+    Recording recording;
+    if (!readWav(argv[1], recording)) {
+      return 1;
+    }
+    const Result result = analyze(recording);
+    printf("%s: %.1fs at %.0fHz, %zu beats detected, %.2fus per block on this machine\n",
+           argv[1], recording.duration(), recording.sample_rate, result.beats.size(), result.micros_per_block);
+    for (double beat : result.beats) {
+      printf("%.3f\n", beat);
+    }
+    if (argc > 2) {
+      const std::vector<double> expected = readBeats(argv[2]);
+      const Accuracy accuracy = score(result.beats, expected);
+      printf("%zu beats: %d hits, %d missed, %d false; precision %.2f, recall %.2f\n",
+             expected.size(), accuracy.hits, accuracy.misses, accuracy.false_beats,
+             accuracy.precision(), accuracy.recall());
+    }
+    return 0;
+  }
+
+  testBands();
+  testBeats();
+  printf("%.2fus per block on this machine\n", analyze(silence(2)).micros_per_block);
+
+  printf("%d failures\n", check::failures_);
+  return check::failures_;
+}
@@ -0,0 +1,40 @@
+/** @file
+ * Timing helpers for the host benchmarks.
+ *
+ * Host timings show how the alternatives compare on the same machine; they
+ * do not predict absolute times on an Uno or ESP32.
+ */
+#ifndef BENCH_H
+#define BENCH_H
+#include <chrono>
+
+namespace bench {
+
+/// Average nanoseconds per call of run(), over at least 20ms of calls.
+template <typename F>
+double nanosPerCall(F run) {
+  typedef std::chrono::steady_clock Clock;
+  for (int i = 0; i < 100; i++) {
+    run();
+  }
+  long calls = 0;
+  const Clock::time_point start = Clock::now();
+  Clock::duration elapsed;
+  do {
+    for (int i = 0; i < 100; i++) {
+      run();
+    }
+    calls += 100;
+    elapsed = Clock::now() - start;
+  } while (elapsed < std::chrono::milliseconds(20));
+  return std::chrono::duration<double, std::nano>(elapsed).count() / calls;
+}
+
+/// Stop the compiler from optimizing away work whose result is in memory at p.
+inline void keep(const void* p) {
+  asm volatile("" : : "g"(p) : "memory");
+}
+
+}  // namespace bench
+
+#endif
@@ -0,0 +1,26 @@
+/** @file
+ * Minimal assertions for the host tests. Each test binary returns the number
+ * of failed checks from main(), so ctest reports any failure.
+ */
+#ifndef CHECK_H
+#define CHECK_H
+#include <stdio.h>
+
+namespace check {
+extern int failures_;
+}
+
+#define CHECK(CONDITION, ...)                                \
+  do {                                                       \
+    if (!(CONDITION)) {                                      \
+      check::failures_++;                                    \
+      printf("%s:%d: check failed: %s: ", __FILE__, __LINE__, #CONDITION); \
+      printf(__VA_ARGS__);                                   \
+      printf("\n");                                          \
+    }                                                        \
+  } while (0)
+
+/// Define once per test binary, before main().
+#define CHECK_MAIN_STATE namespace check { int failures_ = 0; }
+
+#endif
@@ -0,0 +1,22 @@
+# Code size of the animations compiled for each strip configuration in a
+# static library, from the symbol sizes reported by nm. Run by the
+# flash-report target: cmake -DNM=<nm> -DLIBRARY=<library> -P flash-report.cmake
+execute_process(COMMAND ${NM} --demangle --print-size --size-sort ${LIBRARY}
+                OUTPUT_VARIABLE SYMBOLS)
+string(REPLACE "\n" ";" SYMBOLS "${SYMBOLS}")
+
+foreach(config "StripConfig<" "DynamicStripConfig<")
+  set(total 0)
+  foreach(symbol ${SYMBOLS})
+    # <address> <size> <type> <name>, counting code (t/T/w/W) only.
+    if(symbol MATCHES "^[0-9a-f]+ ([0-9a-f]+) [tTwW] (.*)$")
+      set(size ${CMAKE_MATCH_1})
+      set(name "${CMAKE_MATCH_2}")
+      string(FIND "${name}" "animations::${config}" found)
+      if(NOT found EQUAL -1)
+        math(EXPR total "${total} + 0x${size}")
+      endif()
+    endif()
+  endforeach()
+  message("${config}...>: ${total} bytes of code")
+endforeach()
@@ -0,0 +1,49 @@
+/** @file
+ * Times each framebuffer kernel against the per-pixel FastLED loop it
+ * replaces, at several strip lengths.
+ *
+ * Built once per code path: SSE2, 32-bit SWAR and per-byte (as on AVR).
+ */
+#include <FastLED.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench.h"
+#include "src/animation/framebuffer.h"
+
+#define MAX_LEDS 1024
+
+CRGB leds_[MAX_LEDS];
+CRGB source_[MAX_LEDS];
+
+static void report(const char* kernel, uint16_t count, double reference, double kernel_nanos) {
+  printf("%-12s %5u %12.0f %12.0f %8.2fx\n", kernel, count, reference, kernel_nanos, reference / kernel_nanos);
+}
+
+int main(void) {
+  for (uint16_t i = 0; i < MAX_LEDS; i++) {
+    leds_[i] = CRGB(rand(), rand(), rand());
+    source_[i] = CRGB(rand(), rand(), rand());
+  }
+  const CRGB color(40, 200, 90);
+  const uint16_t lengths[] = { 30, 60, 150, 300, 1024 };
+
+  printf("%-12s %5s %12s %12s %9s\n", "kernel", "leds", "loop ns", "kernel ns", "speedup");
+  for (uint16_t count : lengths) {
+    report("fade", count,
+        bench::nanosPerCall([&] { fadeToBlackBy(leds_, count, 20); bench::keep(leds_); }),
+        bench::nanosPerCall([&] { framebuffer::fade(leds_, count, 20); bench::keep(leds_); }));
+    report("add", count,
+        bench::nanosPerCall([&] { for (uint16_t i = 0; i < count; i++) leds_[i] += color; bench::keep(leds_); }),
+        bench::nanosPerCall([&] { framebuffer::add(leds_, count, color); bench::keep(leds_); }));
+    report("lighten", count,
+        bench::nanosPerCall([&] { for (uint16_t i = 0; i < count; i++) leds_[i] |= color; bench::keep(leds_); }),
+        bench::nanosPerCall([&] { framebuffer::lighten(leds_, count, color); bench::keep(leds_); }));
+    report("blendToward", count,
+        bench::nanosPerCall([&] { for (uint16_t i = 0; i < count; i++) nblend(leds_[i], color, 100); bench::keep(leds_); }),
+        bench::nanosPerCall([&] { framebuffer::blendToward(leds_, count, color, 100); bench::keep(leds_); }));
+    report("blend", count,
+        bench::nanosPerCall([&] { for (uint16_t i = 0; i < count; i++) nblend(leds_[i], source_[i], 100); bench::keep(leds_); }),
+        bench::nanosPerCall([&] { framebuffer::blend(leds_, source_, count, 100); bench::keep(leds_); }));
+  }
+  return 0;
+}
@@ -0,0 +1,96 @@
+/** @file
+ * Checks that every framebuffer kernel gives exactly the same result as the
+ * FastLED primitive it replaces, for every strip length up to 170 LEDs and
+ * a few longer ones, with random pixels and parameters.
+ *
+ * Built once per code path: SSE2, 32-bit SWAR and per-byte (as on AVR).
+ */
+#include <FastLED.h>
+#include <stdlib.h>
+#include "check.h"
+#include "src/animation/framebuffer.h"
+
+CHECK_MAIN_STATE
+
+#define MAX_LEDS 1024
+
+CRGB original_[MAX_LEDS];
+CRGB source_[MAX_LEDS];
+CRGB expected_[MAX_LEDS];
+CRGB actual_[MAX_LEDS];
+
+static CRGB randomColor(void) {
+  return CRGB(rand(), rand(), rand());
+}
+
+static void compare(const char* kernel, uint16_t count, int param) {
+  for (uint16_t i = 0; i < count; i++) {
+    if (actual_[i] != expected_[i]) {
+      CHECK(actual_[i] == expected_[i], "%s, %u LEDs, param %d: LED %u", kernel, count, param, i);
+      return;
+    }
+  }
+}
+
+static void testLength(const uint16_t count) {
+  for (uint16_t i = 0; i < count; i++) {
+    original_[i] = randomColor();
+    source_[i] = randomColor();
+  }
+  const CRGB color = randomColor();
+  const uint8_t param = rand();
+
+  memcpy(expected_, original_, sizeof(CRGB) * count);
+  nscale8(expected_, count, param);
+  memcpy(actual_, original_, sizeof(CRGB) * count);
+  framebuffer::scale(actual_, count, param);
+  compare("scale", count, param);
+
+  memcpy(expected_, original_, sizeof(CRGB) * count);
+  fadeToBlackBy(expected_, count, param);
+  memcpy(actual_, original_, sizeof(CRGB) * count);
+  framebuffer::fade(actual_, count, param);
+  compare("fade", count, param);
+
+  memcpy(expected_, original_, sizeof(CRGB) * count);
+  for (uint16_t i = 0; i < count; i++) expected_[i] += color;
+  memcpy(actual_, original_, sizeof(CRGB) * count);
+  framebuffer::add(actual_, count, color);
+  compare("add", count, -1);
+
+  memcpy(expected_, original_, sizeof(CRGB) * count);
+  for (uint16_t i = 0; i < count; i++) expected_[i] |= color;
+  memcpy(actual_, original_, sizeof(CRGB) * count);
+  framebuffer::lighten(actual_, count, color);
+  compare("lighten", count, -1);
+
+  memcpy(expected_, original_, sizeof(CRGB) * count);
+  for (uint16_t i = 0; i < count; i++) nblend(expected_[i], color, param);
+  memcpy(actual_, original_, sizeof(CRGB) * count);
+  framebuffer::blendToward(actual_, count, color, param);
+  compare("blendToward", count, param);
+
+  memcpy(expected_, original_, sizeof(CRGB) * count);
+  for (uint16_t i = 0; i < count; i++) nblend(expected_[i], source_[i], param);
+  memcpy(actual_, original_, sizeof(CRGB) * count);
+  framebuffer::blend(actual_, source_, count, param);
+  compare("blend", count, param);
+}
+
+int main(void) {
+  srand(26);
+  for (int trial = 0; trial < 100; trial++) {
+    for (uint16_t count = 0; count < 170; count++) {
+      testLength(count);
+    }
+  }
+  const uint16_t long_lengths[] = { 256, 300, 511, 1024 };
+  for (int trial = 0; trial < 100; trial++) {
+    for (uint16_t count : long_lengths) {
+      testLength(count);
+    }
+  }
+
+  printf("%d failures\n", check::failures_);
+  return check::failures_;
+}
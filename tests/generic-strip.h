@@ -0,0 +1,20 @@
+/** @file
+ * Extra strip configuration for the strip benchmark, passed to the compiler
+ * with -include so that it comes before strip.h: animations are compiled
+ * for the fixed-length MainStrip and for GenericStrip, one instantiation
+ * for any length up to 1024 LEDs.
+ */
+#ifndef GENERIC_STRIP_H
+#define GENERIC_STRIP_H
+
+#define FOR_EACH_STRIP(X) \
+  X(animations::MainStrip) \
+  X(animations::GenericStrip)
+
+#include "src/animation/strip.h"
+
+namespace animations {
+typedef DynamicStripConfig<1024, COLOR_ORDER> GenericStrip;
+}
+
+#endif
@@ -0,0 +1,73 @@
+/** @file
+ * Frame cost and visual error of keyframe interpolation, for the animations
+ * the sketch renders with a keyframe interval above 1. Each is run at
+ * 120fps against a full render of the same frame: the error is the
+ * difference between the two in each color channel, from 0 to 255.
+ */
+#include <FastLED.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench.h"
+#include "src/animation/animations.h"
+#include "src/animation/keyframes.h"
+
+using animations::MainStrip;
+
+#define FRAME_MILLIS 8
+#define ERROR_FRAMES 2000
+
+CRGB leds_[NUM_LEDS];
+CRGB reference_[NUM_LEDS];
+
+/// Advance the clock by one frame, stepping hue_ every 20ms as the sketch does.
+static void nextFrame(void) {
+  const unsigned long before = millis() / 20;
+  host::advanceMillis(FRAME_MILLIS);
+  animations::hue_ += millis() / 20 - before;
+}
+
+static void report(const char* name, keyframes::Animation animation, uint8_t interval) {
+  animations::palette_ = PartyColors_p;
+
+  const double full = bench::nanosPerCall([&] {
+    nextFrame();
+    animation(leds_);
+    bench::keep(leds_);
+  });
+  keyframes::reset<MainStrip>();
+  const double keyframed = bench::nanosPerCall([&] {
+    nextFrame();
+    keyframes::render<MainStrip>(leds_, animation, interval);
+    bench::keep(leds_);
+  });
+
+  keyframes::reset<MainStrip>();
+  unsigned long total = 0;
+  int worst = 0;
+  for (int frame = 0; frame < ERROR_FRAMES; frame++) {
+    nextFrame();
+    animation(reference_);
+    keyframes::render<MainStrip>(leds_, animation, interval);
+    for (uint16_t i = 0; i < NUM_LEDS; i++) {
+      for (uint8_t channel = 0; channel < 3; channel++) {
+        const int error = abs(leds_[i].raw[channel] - reference_[i].raw[channel]);
+        total += error;
+        worst = error > worst ? error : worst;
+      }
+    }
+  }
+
+  printf("%-18s %8u %10.2f %10.2f %10.2f %6d\n", name, interval, full / 1000, keyframed / 1000,
+         (double) total / ((double) ERROR_FRAMES * NUM_LEDS * 3), worst);
+}
+
+int main(void) {
+  printf("%u LEDs at %ums per frame\n", NUM_LEDS, FRAME_MILLIS);
+  printf("%-18s %8s %10s %10s %10s %6s\n", "animation", "interval", "full us", "keyed us", "mean err", "max");
+  for (uint8_t interval = 2; interval <= 4; interval++) {
+    report("paletteFlow", animations::paletteFlow<MainStrip>, interval);
+    report("polychromeRainbow", animations::polychromeRainbow<MainStrip>, interval);
+    report("polychromeBpm", animations::polychromeBpm<MainStrip>, interval);
+  }
+  return 0;
+}
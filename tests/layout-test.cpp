@@ -0,0 +1,71 @@
+/** @file
+ * Checks the compile-time XY tables against an independent model of each
+ * panel: number the LEDs along the wiring, then turn the panel clockwise.
+ */
+#include <FastLED.h>
+#include "check.h"
+#include "src/layout/layout.h"
+
+CHECK_MAIN_STATE
+
+template <uint8_t WIDTH, uint8_t HEIGHT, bool SERPENTINE, uint8_t ROTATION>
+void testLayout(void) {
+  typedef layout::Matrix<WIDTH, HEIGHT, SERPENTINE, ROTATION> Layout;
+
+  // Quarter turns swap the panel's wired width and height.
+  const uint8_t wired_width = ROTATION & 1 ? HEIGHT : WIDTH;
+  const uint8_t wired_height = ROTATION & 1 ? WIDTH : HEIGHT;
+
+  bool seen[WIDTH * HEIGHT] = {};
+  for (uint16_t led = 0; led < Layout::COUNT; led++) {
+    uint8_t y = led / wired_width;
+    uint8_t x = led % wired_width;
+    if (SERPENTINE && (y & 1)) {
+      x = wired_width - 1 - x;
+    }
+
+    uint8_t height = wired_height;
+    for (uint8_t turn = 0; turn < ROTATION; turn++) {
+      const uint8_t turned_x = height - 1 - y;
+      y = x;
+      x = turned_x;
+      height = height == wired_height ? wired_width : wired_height;
+    }
+
+    CHECK(x < WIDTH && y < HEIGHT, "%ux%u serpentine %d rotation %u: LED %u at (%u, %u)",
+          WIDTH, HEIGHT, SERPENTINE, ROTATION, led, x, y);
+    if (x < WIDTH && y < HEIGHT) {
+      CHECK(Layout::XY(x, y) == led, "%ux%u serpentine %d rotation %u: XY(%u, %u) = %u, expected %u",
+            WIDTH, HEIGHT, SERPENTINE, ROTATION, x, y, Layout::XY(x, y), led);
+      CHECK(Layout::read(Layout::row(y) + x) == led, "%ux%u row(%u)[%u]", WIDTH, HEIGHT, y, x);
+      seen[(uint16_t) y * WIDTH + x] = true;
+    }
+  }
+  for (uint16_t i = 0; i < Layout::COUNT; i++) {
+    CHECK(seen[i], "%ux%u serpentine %d rotation %u: pixel %u has no LED", WIDTH, HEIGHT, SERPENTINE, ROTATION, i);
+  }
+}
+
+template <uint8_t WIDTH, uint8_t HEIGHT>
+void testPanel(void) {
+  testLayout<WIDTH, HEIGHT, false, 0>();
+  testLayout<WIDTH, HEIGHT, false, 1>();
+  testLayout<WIDTH, HEIGHT, false, 2>();
+  testLayout<WIDTH, HEIGHT, false, 3>();
+  testLayout<WIDTH, HEIGHT, true, 0>();
+  testLayout<WIDTH, HEIGHT, true, 1>();
+  testLayout<WIDTH, HEIGHT, true, 2>();
+  testLayout<WIDTH, HEIGHT, true, 3>();
+}
+
+int main(void) {
+  testPanel<16, 16>();
+  testPanel<8, 5>();
+  testPanel<3, 7>();
+  testPanel<32, 32>();
+  static_assert(sizeof(layout::Matrix<16, 16>::LedIndex) == 1, "16x16 panels index with one byte");
+  static_assert(sizeof(layout::Matrix<32, 32>::LedIndex) == 2, "32x32 panels need two bytes");
+
+  printf("%d failures\n", check::failures_);
+  return check::failures_;
+}
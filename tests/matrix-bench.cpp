@@ -0,0 +1,42 @@
+/** @file
+ * Frame cost of the 2D panel animations, against their 1D versions on the
+ * same number of LEDs. Built for a 150-LED strip and for 16x16 and 32x32
+ * panels.
+ */
+#include <FastLED.h>
+#include <stdio.h>
+#include "bench.h"
+#include "src/animation/animations.h"
+
+using animations::MainStrip;
+
+CRGB leds_[NUM_LEDS];
+
+static void report(const char* animation, void (*render)(CRGB leds[])) {
+  animations::palette_ = PartyColors_p;
+  const double nanos = bench::nanosPerCall([&] {
+    host::advanceMillis(8);
+    animations::hue_++;
+    render(leds_);
+    bench::keep(leds_);
+  });
+  printf("%-18s %5u %10.2f\n", animation, NUM_LEDS, nanos / 1000);
+}
+
+int main(void) {
+#ifdef MATRIX_WIDTH
+  printf("%ux%u panel\n", MATRIX_WIDTH, MATRIX_HEIGHT);
+#else
+  printf("%u-LED strip\n", NUM_LEDS);
+#endif
+  printf("%-18s %5s %10s\n", "animation", "leds", "us/frame");
+  report("paletteFlow", animations::paletteFlow<MainStrip>);
+  report("polychromeSinelon", animations::polychromeSinelon<MainStrip>);
+  report("polychromeJuggle", animations::polychromeJuggle<MainStrip>);
+#ifdef MATRIX_WIDTH
+  report("matrixFlow", animations::matrixFlow<MainStrip>);
+  report("matrixSinelon", animations::matrixSinelon<MainStrip>);
+  report("matrixJuggle", animations::matrixJuggle<MainStrip>);
+#endif
+  return 0;
+}
@@ -0,0 +1,58 @@
+/** @file
+ * Frame cost and inoise8() calls per frame of the cached noise animations,
+ * against evaluating both octaves of noise for every LED on every frame.
+ * Built for a 150-LED strip and for 16x16 and 32x32 panels.
+ */
+#include <FastLED.h>
+#include <stdio.h>
+#include "bench.h"
+#include "src/animation/animations.h"
+
+using animations::MainStrip;
+
+#define FRAMES 1000
+
+CRGB leds_[NUM_LEDS];
+
+/// noiseClouds without the lattice cache: two inoise8() calls per LED per frame.
+static void naiveClouds(CRGB leds[]) {
+  static uint32_t scroll = 0;
+  static uint16_t time = 0;
+  scroll += 16;
+  time += 4;
+  for (uint16_t i = 0; i < NUM_LEDS; i++) {
+    const uint32_t position = ((uint32_t) i << 8) + scroll;
+    const uint8_t coarse = inoise8(position >> 5, time >> 2);  // 128 noise units per 16 LEDs
+    const uint8_t fine = inoise8(position >> 3, time);         // 128 noise units per 4 LEDs
+    const uint8_t value = scale8(coarse, 170) + scale8(fine, 85);
+    leds[i] = ColorFromPalette(animations::palette_, animations::hue_ + value, 240, LINEARBLEND);
+  }
+}
+
+static void report(const char* name, void (*render)(CRGB leds[])) {
+  animations::palette_ = LavaColors_p;
+  animations::animation_speed_multiplier_ = 1.0f;
+
+  const uint32_t calls = host::noise_calls_;
+  for (int frame = 0; frame < FRAMES; frame++) {
+    host::advanceMillis(8);
+    render(leds_);
+  }
+  const double calls_per_frame = (double) (host::noise_calls_ - calls) / FRAMES;
+
+  const double nanos = bench::nanosPerCall([&] {
+    host::advanceMillis(8);
+    render(leds_);
+    bench::keep(leds_);
+  });
+  printf("%-12s %5u %12.1f %10.2f\n", name, NUM_LEDS, calls_per_frame, nanos / 1000);
+}
+
+int main(void) {
+  printf("%-12s %5s %12s %10s\n", "animation", "leds", "noise/frame", "us/frame");
+  report("naiveClouds", naiveClouds);
+  report("noiseClouds", animations::noiseClouds<MainStrip>);
+  report("noiseFire", animations::noiseFire<MainStrip>);
+  report("noiseAurora", animations::noiseAurora<MainStrip>);
+  return 0;
+}
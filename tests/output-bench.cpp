@@ -0,0 +1,63 @@
+/** @file
+ * Frame time of serial and pipelined output, for a range of rendering
+ * costs. The transmitter sleeps for as long as the frame takes on the
+ * wire (30us per LED), and rendering is padded with a sleep to the given
+ * cost, as rendering on a microcontroller is far slower than here. Sleeping
+ * rather than spinning lets the two overlap even on a single-core host, as
+ * they do on the ESP32's two cores.
+ */
+#include <FastLED.h>
+#include <stdio.h>
+#include <chrono>
+#include <thread>
+#include "bench.h"
+#include "src/animation/animations.h"
+#include "src/output/output.h"
+
+using animations::MainStrip;
+
+#define FRAMES 300
+
+typedef std::chrono::steady_clock Clock;
+
+static void render(CRGB leds[], uint32_t render_micros) {
+  const Clock::time_point start = Clock::now();
+  host::advanceMillis(8);
+  animations::hue_++;
+  animations::polychromeJuggle<MainStrip>(leds);
+  std::this_thread::sleep_until(start + std::chrono::microseconds(render_micros));
+}
+
+static double microsPerFrame(const Clock::time_point start) {
+  return std::chrono::duration<double, std::micro>(Clock::now() - start).count() / FRAMES;
+}
+
+int main(void) {
+  host::wire_time_ = true;
+  output::setup();
+  CRGB* leds = output::firstBuffer();
+  static CRGB serial[NUM_LEDS];
+  FastLED[0].setLeds(serial, NUM_LEDS);
+
+  printf("%u LEDs, %uus on the wire\n", NUM_LEDS, host::wireMicros(NUM_LEDS));
+  printf("%10s %12s %12s\n", "render us", "serial us", "pipelined us");
+  const uint32_t render_costs[] = { 0, 1000, 2000, 4000, 8000 };
+  for (uint32_t render_micros : render_costs) {
+    FastLED[0].setLeds(serial, NUM_LEDS);
+    Clock::time_point start = Clock::now();
+    for (int frame = 0; frame < FRAMES; frame++) {
+      render(serial, render_micros);
+      FastLED.show();
+    }
+    const double serial_micros = microsPerFrame(start);
+
+    start = Clock::now();
+    for (int frame = 0; frame < FRAMES; frame++) {
+      render(leds, render_micros);
+      leds = output::show(leds);
+    }
+    const double pipelined_micros = microsPerFrame(start);
+    printf("%10u %12.0f %12.0f\n", render_micros, serial_micros, pipelined_micros);
+  }
+  return 0;
+}
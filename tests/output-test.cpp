@@ -0,0 +1,86 @@
+/** @file
+ * Checks that pipelined output sends exactly the frames that rendering and
+ * showing one buffer at a time would, for animations that build on the
+ * previous frame, with the transmitter thread sleeping for the time each
+ * frame takes on the wire.
+ */
+#include <FastLED.h>
+#include <stdio.h>
+#include <mutex>
+#include <vector>
+#include "check.h"
+#include "src/animation/animations.h"
+#include "src/output/output.h"
+
+CHECK_MAIN_STATE
+
+using animations::MainStrip;
+
+#define FRAMES 200
+
+typedef std::vector<CRGB> Frame;
+
+std::mutex mutex_;
+std::vector<Frame> sent_;
+
+static void record(const CRGB* leds, int count) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  sent_.push_back(Frame(leds, leds + count));
+}
+
+static std::vector<Frame> takeSent(void) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<Frame> frames;
+  frames.swap(sent_);
+  return frames;
+}
+
+/// A frame of each animation in turn, so both fading and full redraws are covered.
+static void render(CRGB leds[], int frame) {
+  host::advanceMillis(8);
+  animations::hue_++;
+  if (frame % 50 < 25) {
+    animations::polychromeJuggle<MainStrip>(leds);
+  } else {
+    animations::polychromeSinelon<MainStrip>(leds);
+  }
+}
+
+int main(void) {
+  host::on_show_ = record;
+  host::wire_time_ = true;
+
+  const uint32_t start = host::millis_;
+  const uint8_t start_hue = animations::hue_;
+  static CRGB serial[NUM_LEDS];
+  FastLED[0].setLeds(serial, NUM_LEDS);
+  for (int frame = 0; frame < FRAMES; frame++) {
+    render(serial, frame);
+    FastLED.show();
+  }
+  const std::vector<Frame> expected = takeSent();
+
+  host::millis_ = start;
+  animations::hue_ = start_hue;
+  output::setup();
+  CRGB* leds = output::firstBuffer();
+  fill_solid(leds, NUM_LEDS, CRGB::Black);
+  for (int frame = 0; frame < FRAMES; frame++) {
+    render(leds, frame);
+    leds = output::show(leds);
+  }
+  // Once this one starts, the last real frame has been sent.
+  output::show(leds);
+  const std::vector<Frame> actual = takeSent();
+
+  CHECK(actual.size() >= FRAMES, "%zu frames sent, expected %d", actual.size(), FRAMES);
+  for (int frame = 0; frame < FRAMES && frame < (int) actual.size(); frame++) {
+    if (actual[frame] != expected[frame]) {
+      CHECK(actual[frame] == expected[frame], "frame %d differs", frame);
+      break;
+    }
+  }
+
+  printf("%d failures\n", check::failures_);
+  return check::failures_;
+}
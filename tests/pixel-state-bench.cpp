@@ -0,0 +1,31 @@
+/** @file
+ * Cost of PackedPixelState::advance(), and the RAM the twinkle animations
+ * spend on per-pixel state, at 150 and 300 LEDs.
+ *
+ * Built once per code path: 32-bit SWAR and per-byte (as on AVR).
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench.h"
+#include "src/animation/pixel-state.h"
+
+template <uint16_t COUNT>
+static void report(void) {
+  static PackedPixelState<COUNT> state;
+  for (uint16_t i = 0; i < COUNT; i++) {
+    state.set(i, rand() % 4 == 0 ? rand() % 16 : 0, rand() % 4, rand() % 4);
+  }
+  uint8_t speed = 0;
+  const double nanos = bench::nanosPerCall([&] {
+    state.advance(speed++);
+    bench::keep(&state);
+  });
+  printf("%5u %10zu %12.1f\n", COUNT, sizeof(state), nanos);
+}
+
+int main(void) {
+  printf("%5s %10s %12s\n", "leds", "RAM bytes", "ns/advance");
+  report<150>();
+  report<300>();
+  return 0;
+}
@@ -0,0 +1,66 @@
+/** @file
+ * Checks PackedPixelState against a plain model of its fields, for several
+ * counts around the 4-LED word size and a couple of strip lengths, with
+ * random states and every speed class.
+ *
+ * Built once per code path: 32-bit SWAR and per-byte (as on AVR).
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "check.h"
+#include "src/animation/pixel-state.h"
+
+CHECK_MAIN_STATE
+
+struct Pixel {
+  uint8_t phase;
+  uint8_t speed;
+  uint8_t color;
+};
+
+template <uint16_t COUNT>
+static void testCount(void) {
+  PackedPixelState<COUNT> state;
+  Pixel model[COUNT];
+  for (int round = 0; round < 200; round++) {
+    for (uint16_t i = 0; i < COUNT; i++) {
+      // Mostly idle, as in the twinkle animations, with some LEDs about to wrap.
+      model[i].phase = rand() % 3 == 0 ? (rand() % 2 ? 15 : rand() % 16) : 0;
+      model[i].speed = rand() % PackedPixelState<COUNT>::SPEEDS;
+      model[i].color = rand() % PackedPixelState<COUNT>::COLORS;
+      state.set(i, model[i].phase, model[i].speed, model[i].color);
+    }
+
+    for (int step = 0; step < 20; step++) {
+      const uint8_t speed = rand() % 4;
+      state.advance(speed);
+      for (uint16_t i = 0; i < COUNT; i++) {
+        if (model[i].phase != 0 && model[i].speed == speed) {
+          model[i].phase = (model[i].phase + 1) % PackedPixelState<COUNT>::PHASES;
+        }
+      }
+      for (uint16_t i = 0; i < COUNT; i++) {
+        if (state.phase(i) != model[i].phase || state.speed(i) != model[i].speed || state.color(i) != model[i].color) {
+          CHECK(false, "%u LEDs, LED %u: phase %u speed %u color %u, expected %u %u %u", COUNT, i,
+                state.phase(i), state.speed(i), state.color(i), model[i].phase, model[i].speed, model[i].color);
+          return;
+        }
+      }
+    }
+  }
+}
+
+int main(void) {
+  srand(1);
+  testCount<1>();
+  testCount<3>();
+  testCount<4>();
+  testCount<5>();
+  testCount<8>();
+  testCount<9>();
+  testCount<150>();
+  testCount<301>();
+
+  printf("%d failures\n", check::failures_);
+  return check::failures_;
+}
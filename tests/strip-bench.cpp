@@ -0,0 +1,42 @@
+/** @file
+ * Frame cost of animations compiled for the fixed-length MainStrip against
+ * the same animations compiled once for GenericStrip, a DynamicStripConfig
+ * set to the same length at runtime. See generic-strip.h.
+ */
+#include <FastLED.h>
+#include <stdio.h>
+#include "bench.h"
+#include "src/animation/animations.h"
+
+using animations::GenericStrip;
+using animations::MainStrip;
+
+CRGB leds_[GenericStrip::CAPACITY];
+
+static double microsPerFrame(void (*render)(CRGB leds[])) {
+  animations::palette_ = PartyColors_p;
+  return bench::nanosPerCall([&] {
+    host::advanceMillis(8);
+    animations::hue_++;
+    render(leds_);
+    bench::keep(leds_);
+  }) / 1000;
+}
+
+static void report(const char* name, void (*fixed)(CRGB leds[]), void (*generic)(CRGB leds[])) {
+  const double fixed_micros = microsPerFrame(fixed);
+  const double generic_micros = microsPerFrame(generic);
+  printf("%-18s %5u %10.2f %10.2f\n", name, GenericStrip::LENGTH, fixed_micros, generic_micros);
+}
+
+int main(void) {
+  GenericStrip::LENGTH = MainStrip::LENGTH;
+  printf("%-18s %5s %10s %10s\n", "animation", "leds", "fixed us", "generic us");
+  report("paletteFlow", animations::paletteFlow<MainStrip>, animations::paletteFlow<GenericStrip>);
+  report("polychromeRainbow", animations::polychromeRainbow<MainStrip>, animations::polychromeRainbow<GenericStrip>);
+  report("polychromeJuggle", animations::polychromeJuggle<MainStrip>, animations::polychromeJuggle<GenericStrip>);
+  report("monochromePulse", animations::monochromePulse<MainStrip>, animations::monochromePulse<GenericStrip>);
+  report("twinklePalette", animations::twinklePalette<MainStrip>, animations::twinklePalette<GenericStrip>);
+  report("noiseClouds", animations::noiseClouds<MainStrip>, animations::noiseClouds<GenericStrip>);
+  return 0;
+}
@@ -0,0 +1,267 @@
+/** @file */
+#include "FastLED.h"
+#include <math.h>
+#include <chrono>
+#include <thread>
+
+namespace host {
+
+uint32_t millis_ = 0;
+uint16_t rand16seed_ = 1337;
+uint32_t noise_calls_ = 0;
+bool wire_time_ = false;
+void (*on_show_)(const CRGB* leds, int count) = nullptr;
+
+}  // namespace host
+
+uint8_t sin8(uint8_t theta) {
+  return 128 + (int8_t) lround(127.0 * sin(theta * (2 * M_PI / 256)));
+}
+
+int16_t sin16(uint16_t theta) {
+  return (int16_t) lround(32767.0 * sin(theta * (2 * M_PI / 65536)));
+}
+
+/// Position in the current beat, as in beat88(): 0-65535 once per beat.
+static uint16_t beat88(accum88 beats_per_minute_88) {
+  return ((uint64_t) millis() * beats_per_minute_88 * 280) >> 16;
+}
+
+static uint16_t beat16(accum88 beats_per_minute) {
+  if (beats_per_minute < 256) {
+    beats_per_minute <<= 8;
+  }
+  return beat88(beats_per_minute);
+}
+
+uint8_t beatsin8(accum88 beats_per_minute, uint8_t lowest, uint8_t highest) {
+  const uint8_t beat = beat16(beats_per_minute) >> 8;
+  return lowest + scale8(sin8(beat), highest - lowest);
+}
+
+uint16_t beatsin16(accum88 beats_per_minute, uint16_t lowest, uint16_t highest) {
+  const uint16_t beat = beat16(beats_per_minute);
+  return lowest + scale16(sin16(beat) + 32768, highest - lowest);
+}
+
+uint16_t beatsin88(accum88 beats_per_minute_88, uint16_t lowest, uint16_t highest) {
+  const uint16_t beat = beat88(beats_per_minute_88);
+  return lowest + scale16(sin16(beat) + 32768, highest - lowest);
+}
+
+/*
+ * 2D gradient noise with the same structure and cost as FastLED's
+ * inoise8_raw: a hashed lattice, eased fractions and three lerps.
+ */
+
+static uint8_t permutation(uint8_t i) {
+  static uint8_t table[256];
+  static bool ready = false;
+  if (!ready) {
+    for (int n = 0; n < 256; n++) {
+      table[n] = n;
+    }
+    uint16_t seed = 1;
+    for (int n = 255; n > 0; n--) {
+      seed = seed * 2053 + 13849;
+      const uint8_t swap = seed % (n + 1);
+      const uint8_t t = table[n];
+      table[n] = table[swap];
+      table[swap] = t;
+    }
+    ready = true;
+  }
+  return table[i];
+}
+
+static uint8_t ease8InOutQuad(uint8_t i) {
+  uint8_t j = i;
+  if (j & 0x80) {
+    j = 255 - j;
+  }
+  uint8_t jj2 = scale8(j, j) << 1;
+  if (i & 0x80) {
+    jj2 = 255 - jj2;
+  }
+  return jj2;
+}
+
+static int8_t avg7(int8_t i, int8_t j) {
+  return (i >> 1) + (j >> 1) + (i & 0x1);
+}
+
+static int8_t grad8(uint8_t hash, int8_t x, int8_t y) {
+  int8_t u;
+  int8_t v;
+  if (hash & 4) {
+    u = y;
+    v = x;
+  } else {
+    u = x;
+    v = y;
+  }
+  if (hash & 1) u = -u;
+  if (hash & 2) v = -v;
+  return avg7(u, v);
+}
+
+static int8_t lerp7by8(int8_t a, int8_t b, fract8 frac) {
+  if (b > a) {
+    return a + scale8(b - a, frac);
+  }
+  return a - scale8(a - b, frac);
+}
+
+uint8_t inoise8(uint16_t x, uint16_t y) {
+  host::noise_calls_++;
+  const uint8_t X = x >> 8;
+  const uint8_t Y = y >> 8;
+  const uint8_t A = permutation(X) + Y;
+  const uint8_t AA = permutation(A);
+  const uint8_t AB = permutation(A + 1);
+  const uint8_t B = permutation(X + 1) + Y;
+  const uint8_t BA = permutation(B);
+  const uint8_t BB = permutation(B + 1);
+
+  const uint8_t u = ease8InOutQuad(x);
+  const uint8_t v = ease8InOutQuad(y);
+  const int8_t xx = ((uint8_t) x >> 1) & 0x7F;
+  const int8_t yy = ((uint8_t) y >> 1) & 0x7F;
+  const uint8_t N = 0x80;
+
+  const int8_t x1 = lerp7by8(grad8(permutation(AA), xx, yy), grad8(permutation(BA), xx - N, yy), u);
+  const int8_t x2 = lerp7by8(grad8(permutation(AB), xx, yy - N), grad8(permutation(BB), xx - N, yy - N), u);
+  const int8_t raw = lerp7by8(x1, x2, v);
+  return qadd8(raw + 64, raw + 64);
+}
+
+/**
+ * FastLED's "rainbow" hue wheel gives yellow more room than a plain HSV
+ * wheel. This stub uses the plain wheel: colors differ slightly, cost and
+ * smoothness do not.
+ */
+void hsv2rgb_rainbow(const CHSV& hsv, CRGB& rgb) {
+  const uint8_t section = hsv.hue / 43;
+  const uint8_t offset = (hsv.hue - section * 43) * 6;
+  const uint8_t rising = offset;
+  const uint8_t falling = 255 - offset;
+  uint8_t r;
+  uint8_t g;
+  uint8_t b;
+  switch (section) {
+    case 0: r = 255; g = rising; b = 0; break;
+    case 1: r = falling; g = 255; b = 0; break;
+    case 2: r = 0; g = 255; b = rising; break;
+    case 3: r = 0; g = falling; b = 255; break;
+    case 4: r = rising; g = 0; b = 255; break;
+    default: r = 255; g = 0; b = falling; break;
+  }
+
+  // Desaturate toward white, then dim.
+  const uint8_t white = 255 - hsv.sat;
+  rgb.r = scale8_video(qadd8(scale8(r, hsv.sat), white), hsv.val);
+  rgb.g = scale8_video(qadd8(scale8(g, hsv.sat), white), hsv.val);
+  rgb.b = scale8_video(qadd8(scale8(b, hsv.sat), white), hsv.val);
+}
+
+static const uint32_t PARTY_COLORS[16] = {
+  0x5500AB, 0x84007C, 0xB5004B, 0xE5001B,
+  0xE81700, 0xB84700, 0xAB7700, 0xABAB00,
+  0xAB5500, 0xDD2200, 0xF2000E, 0xC2003E,
+  0x8F0071, 0x5F00A1, 0x2F00D0, 0x0007F9,
+};
+
+static const uint32_t RAINBOW_COLORS[16] = {
+  0xFF0000, 0xD52A00, 0xAB5500, 0xAB7F00,
+  0xABAB00, 0x56D500, 0x00FF00, 0x00D52A,
+  0x00AB55, 0x0056AA, 0x0000FF, 0x2A00D5,
+  0x5500AB, 0x7F0081, 0xAB0055, 0xD5002B,
+};
+
+static const uint32_t LAVA_COLORS[16] = {
+  0x000000, 0x800000, 0x000000, 0x800000,
+  0x8B0000, 0x800000, 0x8B0000, 0x8B0000,
+  0x8B0000, 0xFF0000, 0xFFA500, 0xFFFFFF,
+  0xFFA500, 0xFF0000, 0x8B0000, 0x000000,
+};
+
+const CRGBPalette16 PartyColors_p(PARTY_COLORS);
+const CRGBPalette16 RainbowColors_p(RAINBOW_COLORS);
+const CRGBPalette16 LavaColors_p(LAVA_COLORS);
+
+CRGB ColorFromPalette(const CRGBPalette16& pal, uint8_t index, uint8_t brightness, TBlendType blend_type) {
+  const uint8_t hi4 = index >> 4;
+  const uint8_t lo4 = index & 0x0F;
+  CRGB color = pal[hi4];
+  if (blend_type != NOBLEND && lo4) {
+    const CRGB& next = pal[(hi4 + 1) & 0x0F];
+    const uint8_t f2 = lo4 << 4;
+    const uint8_t f1 = 255 - f2;
+    for (uint8_t i = 0; i < 3; i++) {
+      color.raw[i] = scale8(color.raw[i], f1) + scale8(next.raw[i], f2);
+    }
+  }
+  if (brightness != 255) {
+    color.nscale8_video(brightness);
+  }
+  return color;
+}
+
+void fill_solid(CRGB* leds, int num_to_fill, const CRGB& color) {
+  for (int i = 0; i < num_to_fill; i++) {
+    leds[i] = color;
+  }
+}
+
+void fill_rainbow(CRGB* leds, int num_leds, uint8_t initial_hue, uint8_t delta_hue) {
+  CHSV hsv(initial_hue, 240, 255);
+  for (int i = 0; i < num_leds; i++) {
+    leds[i] = hsv;
+    hsv.hue += delta_hue;
+  }
+}
+
+void fill_palette(CRGB* leds, uint16_t N, uint8_t start_index, uint8_t inc_index,
+                  const CRGBPalette16& pal, uint8_t brightness, TBlendType blend_type) {
+  uint8_t color_index = start_index;
+  for (uint16_t i = 0; i < N; i++) {
+    leds[i] = ColorFromPalette(pal, color_index, brightness, blend_type);
+    color_index += inc_index;
+  }
+}
+
+CRGB& nblend(CRGB& existing, const CRGB& overlay, fract8 amount_of_overlay) {
+  if (amount_of_overlay == 0) {
+    return existing;
+  }
+  if (amount_of_overlay == 255) {
+    existing = overlay;
+    return existing;
+  }
+  for (uint8_t i = 0; i < 3; i++) {
+    existing.raw[i] = blend8(existing.raw[i], overlay.raw[i], amount_of_overlay);
+  }
+  return existing;
+}
+
+void nscale8(CRGB* leds, uint16_t num_leds, uint8_t scale) {
+  for (uint16_t i = 0; i < num_leds; i++) {
+    leds[i].nscale8(scale);
+  }
+}
+
+void fadeToBlackBy(CRGB* leds, uint16_t num_leds, uint8_t fade_by) {
+  nscale8(leds, num_leds, 255 - fade_by);
+}
+
+CFastLED FastLED;
+
+void CFastLED::show(void) {
+  CLEDController& controller = controllers_[0];
+  if (host::on_show_) {
+    host::on_show_(controller.leds(), controller.size());
+  }
+  if (host::wire_time_) {
+    std::this_thread::sleep_for(std::chrono::microseconds(host::wireMicros(controller.size())));
+  }
+}
@@ -0,0 +1,283 @@
+/** @file
+ * Host stand-in for the parts of FastLED used by the sketch's src/ modules.
+ *
+ * The 8-bit math (scale8, qadd8, blend8, ...) and random8/random16 follow
+ * FastLED's portable C implementations exactly, so results from kernels
+ * built on them can be compared byte for byte. Color conversion, palettes,
+ * beatsin and inoise8 follow the same algorithms closely enough for timing
+ * and interpolation-error measurements, but are not bit-exact.
+ *
+ * millis() and micros() read a simulated clock that only moves when a test
+ * calls host::advanceMillis(), so animations are repeatable.
+ *
+ * FastLED.show() hands the controller's LEDs to host::on_show_, if set, and
+ * with host::wire_time_ set sleeps for as long as WS2812B LEDs would take
+ * to receive them.
+ */
+#ifndef HOST_FASTLED_H
+#define HOST_FASTLED_H
+#include <stdint.h>
+#include <string.h>
+
+#define FASTLED_USING_NAMESPACE
+#define FASTLED_NAMESPACE_END
+
+#define PROGMEM
+#define pgm_read_byte(addr) (*(const uint8_t*) (addr))
+#define pgm_read_word(addr) (*(const uint16_t*) (addr))
+
+typedef uint8_t fract8;
+typedef uint16_t accum88;
+
+enum EOrder { RGB = 0012, RBG = 0021, GRB = 0102, GBR = 0120, BRG = 0201, BGR = 0210 };
+enum TBlendType { NOBLEND = 0, LINEARBLEND = 1 };
+
+namespace host {
+
+/// Current time on the simulated clock.
+extern uint32_t millis_;
+
+/// Move the simulated clock on.
+inline void advanceMillis(uint32_t ms) { millis_ += ms; }
+
+}  // namespace host
+
+inline unsigned long millis() { return host::millis_; }
+inline unsigned long micros() { return host::millis_ * 1000UL; }
+
+// 8-bit math, as in lib8tion.
+
+inline uint8_t scale8(uint8_t i, fract8 scale) {
+  return ((uint16_t) i * (1 + (uint16_t) scale)) >> 8;
+}
+
+inline uint8_t scale8_video(uint8_t i, fract8 scale) {
+  return (((uint16_t) i * scale) >> 8) + ((i && scale) ? 1 : 0);
+}
+
+inline uint16_t scale16(uint16_t i, uint16_t scale) {
+  return ((uint32_t) i * (1 + (uint32_t) scale)) >> 16;
+}
+
+inline uint8_t qadd8(uint8_t i, uint8_t j) {
+  const unsigned t = i + j;
+  return t > 255 ? 255 : t;
+}
+
+inline uint8_t qsub8(uint8_t i, uint8_t j) {
+  return i > j ? i - j : 0;
+}
+
+inline uint8_t blend8(uint8_t a, uint8_t b, uint8_t amount_of_b) {
+  uint16_t partial = (a << 8) | b;
+  partial += b * amount_of_b;
+  partial -= a * amount_of_b;
+  return partial >> 8;
+}
+
+inline uint8_t lerp8by8(uint8_t a, uint8_t b, fract8 frac) {
+  if (b > a) {
+    return a + scale8(b - a, frac);
+  }
+  return a - scale8(a - b, frac);
+}
+
+inline long map(long x, long in_min, long in_max, long out_min, long out_max) {
+  return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+// Pseudo-random numbers, as in lib8tion/random8.h.
+
+namespace host {
+extern uint16_t rand16seed_;
+}
+
+inline void random16_set_seed(uint16_t seed) { host::rand16seed_ = seed; }
+
+inline uint16_t random16() {
+  host::rand16seed_ = (host::rand16seed_ * 2053) + 13849;
+  return host::rand16seed_;
+}
+
+inline uint16_t random16(uint16_t lim) {
+  return ((uint32_t) random16() * lim) >> 16;
+}
+
+inline uint8_t random8() {
+  random16();
+  return (uint8_t) (host::rand16seed_ & 0xFF) + (uint8_t) (host::rand16seed_ >> 8);
+}
+
+inline uint8_t random8(uint8_t lim) {
+  return ((uint16_t) random8() * lim) >> 8;
+}
+
+// Waves and noise.
+
+uint8_t sin8(uint8_t theta);
+int16_t sin16(uint16_t theta);
+uint8_t beatsin8(accum88 beats_per_minute, uint8_t lowest = 0, uint8_t highest = 255);
+uint16_t beatsin16(accum88 beats_per_minute, uint16_t lowest = 0, uint16_t highest = 65535);
+uint16_t beatsin88(accum88 beats_per_minute_88, uint16_t lowest = 0, uint16_t highest = 65535);
+uint8_t inoise8(uint16_t x, uint16_t y);
+
+namespace host {
+/// Number of inoise8() calls so far, to compare noise caching strategies.
+extern uint32_t noise_calls_;
+}
+
+// Colors.
+
+struct CHSV {
+  union {
+    struct {
+      uint8_t hue;
+      uint8_t sat;
+      uint8_t val;
+    };
+    uint8_t raw[3];
+  };
+
+  CHSV() {}
+  CHSV(uint8_t h, uint8_t s, uint8_t v) : hue(h), sat(s), val(v) {}
+};
+
+struct CRGB;
+void hsv2rgb_rainbow(const CHSV& hsv, CRGB& rgb);
+
+struct CRGB {
+  union {
+    struct {
+      uint8_t r;
+      uint8_t g;
+      uint8_t b;
+    };
+    uint8_t raw[3];
+  };
+
+  enum HTMLColorCode {
+    Black = 0x000000,
+    Gold = 0xFFD700,
+    OldLace = 0xFDF5E6,
+    Pink = 0xFFC0CB,
+    White = 0xFFFFFF,
+    FairyLight = 0xFFE42D,
+    FairyLightNCC = 0xFF9D2A,
+  };
+
+  CRGB() {}
+  CRGB(uint8_t ir, uint8_t ig, uint8_t ib) : r(ir), g(ig), b(ib) {}
+  CRGB(uint32_t colorcode) : r(colorcode >> 16), g(colorcode >> 8), b(colorcode) {}
+  CRGB(HTMLColorCode colorcode) : CRGB((uint32_t) colorcode) {}
+  CRGB(const CHSV& hsv) { hsv2rgb_rainbow(hsv, *this); }
+
+  uint8_t& operator[](uint8_t x) { return raw[x]; }
+  const uint8_t& operator[](uint8_t x) const { return raw[x]; }
+
+  CRGB& operator+=(const CRGB& rhs) {
+    r = qadd8(r, rhs.r);
+    g = qadd8(g, rhs.g);
+    b = qadd8(b, rhs.b);
+    return *this;
+  }
+
+  CRGB& operator|=(const CRGB& rhs) {
+    if (rhs.r > r) r = rhs.r;
+    if (rhs.g > g) g = rhs.g;
+    if (rhs.b > b) b = rhs.b;
+    return *this;
+  }
+
+  CRGB& nscale8(uint8_t scaledown) {
+    r = scale8(r, scaledown);
+    g = scale8(g, scaledown);
+    b = scale8(b, scaledown);
+    return *this;
+  }
+
+  CRGB& nscale8_video(uint8_t scaledown) {
+    r = scale8_video(r, scaledown);
+    g = scale8_video(g, scaledown);
+    b = scale8_video(b, scaledown);
+    return *this;
+  }
+
+  bool operator==(const CRGB& rhs) const { return r == rhs.r && g == rhs.g && b == rhs.b; }
+  bool operator!=(const CRGB& rhs) const { return !(*this == rhs); }
+};
+
+struct CRGBPalette16 {
+  CRGB entries[16];
+
+  CRGBPalette16() {
+    for (uint8_t i = 0; i < 16; i++) {
+      entries[i] = CRGB(0, 0, 0);
+    }
+  }
+  CRGBPalette16(const uint32_t colors[16]) {
+    for (uint8_t i = 0; i < 16; i++) {
+      entries[i] = CRGB(colors[i]);
+    }
+  }
+
+  CRGB& operator[](uint8_t x) { return entries[x]; }
+  const CRGB& operator[](uint8_t x) const { return entries[x]; }
+};
+
+extern const CRGBPalette16 PartyColors_p;
+extern const CRGBPalette16 RainbowColors_p;
+extern const CRGBPalette16 LavaColors_p;
+
+CRGB ColorFromPalette(const CRGBPalette16& pal, uint8_t index, uint8_t brightness = 255, TBlendType blend_type = LINEARBLEND);
+
+void fill_solid(CRGB* leds, int num_to_fill, const CRGB& color);
+void fill_rainbow(CRGB* leds, int num_leds, uint8_t initial_hue, uint8_t delta_hue = 5);
+void fill_palette(CRGB* leds, uint16_t N, uint8_t start_index, uint8_t inc_index,
+                  const CRGBPalette16& pal, uint8_t brightness, TBlendType blend_type);
+CRGB& nblend(CRGB& existing, const CRGB& overlay, fract8 amount_of_overlay);
+void nscale8(CRGB* leds, uint16_t num_leds, uint8_t scale);
+void fadeToBlackBy(CRGB* leds, uint16_t num_leds, uint8_t fade_by);
+
+// Output.
+
+namespace host {
+
+/// If true, FastLED.show() takes as long as sending the LEDs over the wire.
+extern bool wire_time_;
+
+/// Called by FastLED.show() with the LEDs it sends, from whichever thread called it.
+extern void (*on_show_)(const CRGB* leds, int count);
+
+/// Time to send count WS2812B LEDs: 24 bits at 1.25us each, plus the 50us latch.
+inline uint32_t wireMicros(int count) { return count * 30 + 50; }
+
+}  // namespace host
+
+class CLEDController {
+ public:
+  void setLeds(CRGB* leds, int count) {
+    leds_ = leds;
+    count_ = count;
+  }
+  CRGB* leds(void) { return leds_; }
+  int size(void) const { return count_; }
+
+ private:
+  CRGB* leds_ = nullptr;
+  int count_ = 0;
+};
+
+class CFastLED {
+ public:
+  CLEDController& operator[](int x) { return controllers_[x]; }
+  void setBrightness(uint8_t scale) { brightness_ = scale; }
+  void show(void);
+
+ private:
+  CLEDController controllers_[1];
+  uint8_t brightness_ = 255;
+};
+
+extern CFastLED FastLED;
+
+#endif